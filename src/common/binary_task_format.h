@@ -0,0 +1,30 @@
+#ifndef BINARY_TASK_FORMAT_H
+#define BINARY_TASK_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+  Constants of the binary task format, written by the preprocessor
+  (preprocess/task_writer.h) and read by the search component
+  (search/task_reader.cc). The search
+  component checks the magic number and the version, so change the
+  version if the format changes.
+
+  The file starts with BINARY_TASK_MAGIC and BINARY_TASK_VERSION, padded
+  to BINARY_TASK_HEADER_SIZE bytes. Each value follows as a token in
+  native byte order: a tag byte, followed by an int64 (TOKEN_INT), a
+  double (TOKEN_FLOAT) or a uint32 length and the characters
+  (TOKEN_STRING).
+*/
+static const char BINARY_TASK_MAGIC[8] = {'N', 'F', 'D', 'T', 'A', 'S', 'K', 'B'};
+static const uint32_t BINARY_TASK_VERSION = 1;
+static const size_t BINARY_TASK_HEADER_SIZE = 16;
+
+enum BinaryTaskToken : uint8_t {
+    TOKEN_INT = 1,
+    TOKEN_FLOAT = 2,
+    TOKEN_STRING = 3
+};
+
+#endif
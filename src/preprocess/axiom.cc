@@ -1,5 +1,6 @@
 #include "helper_functions.h"
 #include "axiom.h"
+#include "task_writer.h"
 #include "variable.h"
 
 #include <iostream>
@@ -178,7 +179,7 @@ int Axiom_relational::get_encoding_size() const {
     return 1 + conditions.size();
 }
 
-void Axiom_relational::generate_cpp_input(ofstream &outfile) const {
+void Axiom_relational::generate_cpp_input(TaskWriter &outfile) const {
     assert(effect_var->get_level() != -1);
     outfile << "begin_rule" << endl;
     outfile << conditions.size() << endl;
@@ -196,7 +197,7 @@ void Axiom_relational::generate_cpp_input(ofstream &outfile) const {
 //	}
 //}
 
-void Axiom_numeric_computation::generate_cpp_input(ofstream &outfile) const
+void Axiom_numeric_computation::generate_cpp_input(TaskWriter &outfile) const
 {
     assert(effect_var->get_level() != -1);
     assert(left_var->get_level() != -1);
@@ -206,7 +207,7 @@ void Axiom_numeric_computation::generate_cpp_input(ofstream &outfile) const
     outfile << " " << left_var->get_level() << " " << right_var->get_level() << endl;
 }
 
-void Axiom_functional_comparison::generate_cpp_input(ofstream &outfile) const
+void Axiom_functional_comparison::generate_cpp_input(TaskWriter &outfile) const
 {
     assert(effect_var->get_level() != -1);
     outfile << effect_var->get_level() << " ";
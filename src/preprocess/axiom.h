@@ -7,6 +7,7 @@
 #include <vector>
 using namespace std;
 
+class TaskWriter;
 class Variable;
 class NumericVariable;
 
@@ -29,7 +30,7 @@ public:
     string str() const;
     void dump() const;
     int get_encoding_size() const;
-    void generate_cpp_input(ofstream &outfile) const;
+    void generate_cpp_input(TaskWriter &outfile) const;
     const vector<Condition> &get_conditions() const {return conditions; }
     Variable *get_effect_var() const {return effect_var; }
     int get_old_val() const {return old_val; }
@@ -51,7 +52,7 @@ class Axiom_functional_comparison
         void dump() const;
         void set_relevant() const;
         int get_encoding_size() const;
-        void generate_cpp_input(ofstream &outfile) const;
+        void generate_cpp_input(TaskWriter &outfile) const;
         Variable* get_effect_var() const {
             return effect_var;
         }
@@ -79,7 +80,7 @@ class Axiom_numeric_computation
 //        void set_instrumentation() const;
         void dump() const;
         int get_encoding_size() const;
-        void generate_cpp_input(ofstream &outfile) const;
+        void generate_cpp_input(TaskWriter &outfile) const;
         NumericVariable* get_effect_var() const {
             return effect_var;
         }
@@ -15,6 +15,7 @@ using namespace std;
 #include "axiom.h"
 #include "variable.h"
 #include "successor_generator.h"
+#include "task_writer.h"
 #include "domain_transition_graph.h"
 
 
@@ -314,12 +315,14 @@ void generate_cpp_input(bool /*solvable_in_poly_time*/,
                         const vector<Axiom_relational> &axioms_rel,
                         const vector<Axiom_numeric_computation> &axioms_func_ass,
                         const vector<Axiom_functional_comparison> &axioms_func_comp,
-			const GlobalConstraint &constraint) {
+			const GlobalConstraint &constraint,
+                        bool binary_output) {
     /* NOTE: solvable_in_poly_time flag is no longer included in output,
        since the planner doesn't handle it specially any more anyway. */
 
-    ofstream outfile;
-    outfile.open("output", ios::out);
+    ofstream file;
+    file.open("output", binary_output ? ios::out | ios::binary : ios::out);
+    TaskWriter outfile(file, binary_output);
 
     outfile << "begin_version" << endl;
     outfile << PRE_FILE_VERSION << endl;
@@ -409,7 +412,7 @@ void generate_cpp_input(bool /*solvable_in_poly_time*/,
 
     outfile << "begin_SG" << endl;
 
-    outfile.close();
+    file.close();
 }
 
 istream& operator>>(istream &is, foperator &fop) {
@@ -1,6 +1,7 @@
 #include "mutex_group.h"
 
 #include "helper_functions.h"
+#include "task_writer.h"
 #include "variable.h"
 
 #include <fstream>
@@ -32,7 +33,7 @@ void MutexGroup::dump() const {
     }
 }
 
-void MutexGroup::generate_cpp_input(ofstream &outfile) const {
+void MutexGroup::generate_cpp_input(TaskWriter &outfile) const {
     outfile << "begin_mutex_group" << endl
             << facts.size() << endl;
     for (const auto &fact : facts) {
@@ -1,5 +1,6 @@
 #include "helper_functions.h"
 #include "operator.h"
+#include "task_writer.h"
 #include "variable.h"
 
 #include <cassert>
@@ -143,7 +144,7 @@ void strip_operators(vector<Operator> &operators) {
     cout << operators.size() << " of " << old_count << " operators necessary." << endl;
 }
 
-void Operator::generate_cpp_input(ofstream &outfile) const {
+void Operator::generate_cpp_input(TaskWriter &outfile) const {
     //TODO: beim Einlesen in search feststellen, ob leerer Operator
 //	cout << "generating cpp input for operator " << name << endl;
 //	dump();
@@ -8,6 +8,7 @@
 #include "helper_functions.h"
 using namespace std;
 
+class TaskWriter;
 class Variable;
 class NumericVariable;
 
@@ -66,7 +67,7 @@ public:
 
     void dump() const;
     int get_encoding_size() const;
-    void generate_cpp_input(ofstream &outfile) const;
+    void generate_cpp_input(TaskWriter &outfile) const;
     int get_cost() const {return cost; }
     string get_name() const {return name; }
     const vector<Prevail> &get_prevail() const {return prevail; }
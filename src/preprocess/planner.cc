@@ -3,7 +3,7 @@
  * goals, initial state),
  * then calls functions to build causal graph, domain_transition_graphs and
  * successor generator
- * finally prints output to file "output"
+ * finally prints output to file "output" (text or binary format)
  */
 
 #include "helper_functions.h"
@@ -21,6 +21,22 @@
 using namespace std;
 
 int main(int argc, const char **argv) {
+    /*
+      With --binary-output, the output is written in the binary format (see
+      task_writer.h). The option is removed before the other arguments are
+      handled below.
+    */
+    bool binary_output = false;
+    vector<const char *> args;
+    for (int i = 0; i < argc; ++i) {
+        if (string(argv[i]) == "--binary-output")
+            binary_output = true;
+        else
+            args.push_back(argv[i]);
+    }
+    argc = args.size();
+    argv = args.data();
+
     Metric  metric;
     vector<Variable *> variables; // variables ordered beneficially (according to causal graph) without pruned variables
     vector<Variable> internal_variables; // includes variables that will be pruned away, ordered according to input file
@@ -147,7 +163,7 @@ int main(int argc, const char **argv) {
     cout << "Writing output..." << endl;
     generate_cpp_input(solveable_in_poly_time, ordering, numeric_ordering, metric,
                        mutexes, initial_state, goals, operators, axioms_rel,
-					   axioms_numeric, axioms_func_comp, global_constraint);
+					   axioms_numeric, axioms_func_comp, global_constraint, binary_output);
     cout << "done" << endl;
 
 //    cout << "-----------------------------------------------\n Eliminated Variables : \n--------------------------------------------------" << endl;
@@ -0,0 +1,80 @@
+#ifndef TASK_WRITER_H
+#define TASK_WRITER_H
+
+#include <binary_task_format.h>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+using namespace std;
+
+/*
+  Writes the output for the search component. It is used like an ostream.
+  In text mode, everything is forwarded to the file with the default
+  stream precision. In binary mode, the values are written as tokens in
+  the format described in binary_task_format.h, so floating-point values
+  keep their full precision. Separators and line ends are dropped,
+  so every value is one token, even if it contains spaces. Values of other
+  types (e.g. operators) are written as strings in their text
+  representation.
+*/
+class TaskWriter {
+    ofstream &out;
+    const bool binary;
+
+    template<typename T>
+    void write_raw(const T &value) {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    void write_string(const string &value) {
+        write_raw(TOKEN_STRING);
+        write_raw<uint32_t>(value.size());
+        out.write(value.data(), value.size());
+    }
+public:
+    TaskWriter(ofstream &out, bool binary) : out(out), binary(binary) {
+        static_assert(sizeof(BINARY_TASK_MAGIC) + sizeof(BINARY_TASK_VERSION) +
+                      sizeof(uint32_t) == BINARY_TASK_HEADER_SIZE,
+                      "header padding does not match BINARY_TASK_HEADER_SIZE");
+        if (binary) {
+            out.write(BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC));
+            write_raw(BINARY_TASK_VERSION);
+            write_raw<uint32_t>(0);
+        }
+    }
+
+    template<typename T>
+    TaskWriter &operator<<(const T &value) {
+        if (!binary) {
+            out << value;
+        } else if constexpr (is_same<T, char>::value) {
+            write_string(string(1, value));
+        } else if constexpr (is_integral<T>::value) {
+            write_raw(TOKEN_INT);
+            write_raw<int64_t>(value);
+        } else if constexpr (is_floating_point<T>::value) {
+            write_raw(TOKEN_FLOAT);
+            write_raw<double>(value);
+        } else if constexpr (is_convertible<const T &, string>::value) {
+            string text(value);
+            if (text.find_first_not_of(" \t\n") != string::npos)
+                write_string(text);
+        } else {
+            ostringstream text;
+            text << value;
+            write_string(text.str());
+        }
+        return *this;
+    }
+
+    // Line ends (endl) are only written in text mode.
+    TaskWriter &operator<<(ostream &(*manipulator)(ostream &)) {
+        if (!binary)
+            out << manipulator;
+        return *this;
+    }
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "variable.h"
 
 #include "helper_functions.h"
+#include "task_writer.h"
 
 #include <sstream>
 #include <cassert>
@@ -94,7 +95,7 @@ void Variable::dump() const {
     cout << "}" << endl;
 }
 
-void Variable::generate_cpp_input(ofstream &outfile) const {
+void Variable::generate_cpp_input(TaskWriter &outfile) const {
     outfile << "begin_variable" << endl
             << name << endl
             << layer << endl
@@ -176,7 +177,7 @@ void NumericVariable::dump() const {
     cout << "<"<< endl;
 }
 
-void NumericVariable::generate_cpp_input(ofstream &outfile) const {
+void NumericVariable::generate_cpp_input(TaskWriter &outfile) const {
 	assert(necessary);
 	assert(layer >= -1);
     outfile << ntype << " " << layer << " " << name << endl;
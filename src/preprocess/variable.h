@@ -6,6 +6,8 @@
 
 using namespace std;
 
+class TaskWriter;
+
 enum numType
 {
 	unknown = 0, // will be pruned away
@@ -37,7 +39,7 @@ public:
     int get_layer() const {return layer; }
     void decrement_layer(int decrement);
     bool is_derived() const {return layer != -1;}
-    void generate_cpp_input(ofstream &outfile) const;
+    void generate_cpp_input(TaskWriter &outfile) const;
     void dump() const;
     string get_fact_name(int value) const {return values[value]; }
     void set_fact_name(int value, string new_name); // used to rename comparison axiom facts
@@ -66,7 +68,7 @@ public:
     int get_layer() const {return layer; }
     bool is_derived() const {return (ntype == derived);}
     numType get_type() const {return ntype; }
-    void generate_cpp_input(ofstream &outfile) const;
+    void generate_cpp_input(TaskWriter &outfile) const;
     void dump() const;
 };
 
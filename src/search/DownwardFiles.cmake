@@ -21,11 +21,14 @@ set(CORE_SOURCES
         globals.cc
         global_state.cc
         heuristic_cache.cc
+        projection_cache.cc
         heuristic.cc
         int_packer.cc
+        numeric_encoding.cc
         operator_cost.cc
         option_parser.h
         option_parser_util.h
+        per_state_bitset.cc
         per_state_information.cc
         plugin.h
         pruning_method.cc
@@ -38,10 +41,12 @@ set(CORE_SOURCES
         search_space.cc
         search_statistics.cc
         segmented_vector.cc
+        state_hash_table.cc
         state_id.cc
         state_registry.cc
         successor_generator.cc
         task_proxy.cc
+        task_reader.cc
         task_tools.cc
         variable_order_finder.cc
 
@@ -51,6 +56,7 @@ set(CORE_SOURCES
         open_lists/open_list.cc
         open_lists/open_list_factory.cc
         open_lists/pareto_open_list.cc
+        open_lists/radix_open_list.cc
         open_lists/standard_scalar_open_list.cc
         open_lists/tiebreaking_open_list.cc
         open_lists/type_based_open_list.cc
@@ -128,6 +134,7 @@ fast_downward_plugin(
         utils/hash.h
         utils/language.h
         utils/logging.cc
+        utils/mapped_file.cc
         utils/markup.cc
         utils/math.cc
         utils/memory.cc
@@ -248,6 +255,13 @@ fast_downward_plugin(
     DEPENDS SEARCH_COMMON PREF_EVALUATOR G_EVALUATOR
 )
 
+fast_downward_plugin(
+    NAME PARALLEL_EAGER_SEARCH
+    HELP "Hash-distributed parallel A* search"
+    SOURCES
+        search_engines/parallel_eager_search.cc
+)
+
 fast_downward_plugin(
     NAME ITERATED_SEARCH
     HELP "Iterated search algorithm"
@@ -461,6 +475,7 @@ fast_downward_plugin(
     HELP "Heuristics for the Numeric variant NFD"
     SOURCES
         numeric/interval.cc
+        numeric/interval_batch.cc
         numeric/relaxed_interval_helper.cc
         numeric/interval_relaxation_heuristic.cc
         numeric/interval_max_heuristic.cc
@@ -562,6 +577,14 @@ fast_downward_plugin(
 #        gurobi_compilation/relevance_constraints.cc
 #)
 
+fast_downward_plugin(
+    NAME PDB_CACHE
+    HELP "Binary files for storing PDBs between runs"
+    SOURCES
+        pdbs/pdb_cache.cc
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME PDBS
     HELP "Plugin containing the code for PDBs"
@@ -588,6 +611,7 @@ fast_downward_plugin(
         pdbs/validation.cc
         pdbs/zero_one_pdbs.cc
         pdbs/zero_one_pdbs_heuristic.cc
+    DEPENDS PDB_CACHE
 )
 
 fast_downward_plugin(
@@ -618,6 +642,7 @@ fast_downward_plugin(
         numeric_pdbs/types.cc
         numeric_pdbs/validation.cc
         numeric_pdbs/variable_order_finder.cc
+    DEPENDS PDB_CACHE
 )
 
 fast_downward_plugin(
@@ -2,14 +2,16 @@
 #include "global_operator.h"
 #include "globals.h"
 #include "int_packer.h"
+#include "task_reader.h"
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iostream>
 #include <vector>
 using namespace std;
 
-PropositionalAxiom::PropositionalAxiom(istream &in) : layer(-1){
+PropositionalAxiom::PropositionalAxiom(TaskReader &in) : layer(-1){
     check_magic(in, "begin_rule");
     int cond_count;
     in >> cond_count;
@@ -35,7 +37,7 @@ void PropositionalAxiom::dump() const
             << effects[0].val << endl;
 }
 
-ComparisonAxiom::ComparisonAxiom(istream &in) {
+ComparisonAxiom::ComparisonAxiom(TaskReader &in) {
 	int av, vl, vr;
 	comp_operator co;
 	in >> av >> co >> vl >> vr;
@@ -45,7 +47,7 @@ ComparisonAxiom::ComparisonAxiom(istream &in) {
 	var_rhs = vr;
 }
 
-AssignmentAxiom::AssignmentAxiom(istream &in) {
+AssignmentAxiom::AssignmentAxiom(TaskReader &in) {
 	int av, vl, vr;
 	cal_operator fo;
 	in >> av >> fo >> vl >> vr;
@@ -75,7 +77,9 @@ void AssignmentAxiom::dump() const {
 }
 
 
-AxiomEvaluator::AxiomEvaluator() {
+AxiomEvaluator::AxiomEvaluator()
+    : num_incremental_evaluations(0),
+      num_logic_evaluations(0) {
     // Handle axioms in the following order:
     // 1) Arithmetic axioms (layers 0 through k-1)
     // 2) Comparison axioms (layer k)
@@ -166,6 +170,8 @@ AxiomEvaluator::AxiomEvaluator() {
             nbf_info_by_layer[layer].push_back(nbf_info);
         }
     }
+
+    compile_numeric_axioms();
 }
 
 void AxiomEvaluator::evaluate(PackedStateBin *buffer, vector<ap_float> &numeric_state) {
@@ -200,127 +206,310 @@ void AxiomEvaluator::evaluate(vector<int> &state, vector<ap_float> &numeric_stat
     }
 }
 
-void AxiomEvaluator::evaluate_arithmetic_axioms(vector<ap_float> &numeric_state)
-{
-//	int current_layer = -1;
-	for (const auto & ax : g_ass_axioms) {
-		assert(g_numeric_var_names.size() == numeric_state.size());
-//		int next_layer = g_numeric_axiom_layers[ax.affected_variable];
-//		assert(next_layer >= current_layer);
-//		current_layer = next_layer;
-		assert(ax.affected_variable < (int) numeric_state.size());
-		assert(ax.var_lhs < (int) numeric_state.size());
-		assert(ax.var_rhs < (int) numeric_state.size());
-		ap_float left = numeric_state[ax.var_lhs];
-		ap_float right = numeric_state[ax.var_rhs];
-		ap_float result;
-//		if(DEBUG) cout << "evaluating numeric assignment axiom: ";
-//		if(DEBUG) cout << g_numeric_var_names[ax.affected_variable] << " := "
-//				<< g_numeric_var_names[ax.var_lhs] << " " << ax.op << " " << g_numeric_var_names[ax.var_rhs] << endl;
-		switch(ax.op) {
-		case sum:
-			result = left + right;
-			numeric_state[ax.affected_variable] = result;
-			break;
-		case diff:
-			result = left - right;
-			numeric_state[ax.affected_variable] = result;
-			break;
-		case mult:
-			result = left * right;
-			numeric_state[ax.affected_variable] = result;
-			break;
-		case divi:
-			result = left / right;
-			numeric_state[ax.affected_variable] = result;
-			break;
-		default:
-			cout << "Error: No assignment operators are allowed here." << endl;
-			assert(false);
-			break;
-		}
-	}
+template<typename Operation>
+static void evaluate_arithmetic_group(const int *lhs, const int *rhs, const int *affected_var,
+                                      int begin, int end, ap_float *values,
+                                      Operation operation) {
+    for (int i = begin; i < end; ++i)
+        values[affected_var[i]] = operation(values[lhs[i]], values[rhs[i]]);
+}
+
+template<typename Operation>
+static void evaluate_comparison_group(const int *lhs, const int *rhs,
+                                      int begin, int end, const ap_float *values,
+                                      char *results, Operation operation) {
+    for (int i = begin; i < end; ++i)
+        results[i] = operation(values[lhs[i]], values[rhs[i]]);
+}
+
+static ap_float apply_cal_operator(int op, ap_float left, ap_float right) {
+    switch (op) {
+    case sum:
+        return left + right;
+    case diff:
+        return left - right;
+    case mult:
+        return left * right;
+    case divi:
+        return left / right;
+    default:
+        cout << "Error: No assignment operators are allowed here." << endl;
+        assert(false);
+        return 0;
+    }
+}
+
+static bool apply_comp_operator(int op, ap_float left, ap_float right) {
+    switch (op) {
+    case lt:
+        return left < right;
+    case le:
+        return left <= right;
+    case eq:
+        return left == right;
+    case ge:
+        return left >= right;
+    case gt:
+        return left > right;
+    case ue:
+        return left != right;
+    default:
+        cout << "Error: No comparison operators are allowed here." << endl;
+        assert(false);
+        return false;
+    }
+}
+
+static void add_axiom(const Axiom &axiom, int var_lhs, int var_rhs, int op,
+                      vector<int> &lhs, vector<int> &rhs,
+                      vector<int> &affected_var, vector<int> &ops,
+                      vector<vector<int>> &axioms_by_input) {
+    int pos = lhs.size();
+    lhs.push_back(var_lhs);
+    rhs.push_back(var_rhs);
+    affected_var.push_back(axiom.affected_variable);
+    ops.push_back(op);
+    axioms_by_input[var_lhs].push_back(pos);
+    if (var_rhs != var_lhs)
+        axioms_by_input[var_rhs].push_back(pos);
+}
+
+void AxiomEvaluator::compile_numeric_axioms() {
+    // g_ass_axioms is sorted by layer, we additionally group by operator.
+    arithmetic_axioms.axioms_by_input.resize(g_numeric_var_names.size());
+    comparison_axioms.axioms_by_input.resize(g_numeric_var_names.size());
+    vector<int> order(g_ass_axioms.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    stable_sort(order.begin(), order.end(), [](int a, int b) {
+            const AssignmentAxiom &ax_a = g_ass_axioms[a];
+            const AssignmentAxiom &ax_b = g_ass_axioms[b];
+            int layer_a = g_numeric_axiom_layers[ax_a.affected_variable];
+            int layer_b = g_numeric_axiom_layers[ax_b.affected_variable];
+            return make_pair(layer_a, ax_a.op) < make_pair(layer_b, ax_b.op);
+        });
+    int last_layer = -1;
+    for (int index : order) {
+        const AssignmentAxiom &ax = g_ass_axioms[index];
+        int layer = g_numeric_axiom_layers[ax.affected_variable];
+        int pos = arithmetic_axioms.lhs.size();
+        if (arithmetic_axioms.groups.empty() || layer != last_layer ||
+            arithmetic_axioms.groups.back().op != ax.op) {
+            arithmetic_axioms.groups.push_back({pos, pos, ax.op});
+        }
+        last_layer = layer;
+        add_axiom(ax, ax.var_lhs, ax.var_rhs, ax.op,
+                  arithmetic_axioms.lhs, arithmetic_axioms.rhs,
+                  arithmetic_axioms.affected_var, arithmetic_axioms.op,
+                  arithmetic_axioms.axioms_by_input);
+        ++arithmetic_axioms.groups.back().end;
+    }
+
+    order.resize(g_comp_axioms.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    stable_sort(order.begin(), order.end(), [](int a, int b) {
+            return g_comp_axioms[a].op < g_comp_axioms[b].op;
+        });
+    for (int index : order) {
+        const ComparisonAxiom &ax = g_comp_axioms[index];
+        int pos = comparison_axioms.lhs.size();
+        if (comparison_axioms.groups.empty() || comparison_axioms.groups.back().op != ax.op)
+            comparison_axioms.groups.push_back({pos, pos, ax.op});
+        add_axiom(ax, ax.var_lhs, ax.var_rhs, ax.op,
+                  comparison_axioms.lhs, comparison_axioms.rhs,
+                  comparison_axioms.affected_var, comparison_axioms.op,
+                  comparison_axioms.axioms_by_input);
+        ++comparison_axioms.groups.back().end;
+    }
+    comparison_results.resize(g_comp_axioms.size());
+
+    is_logic_axiom_input.assign(g_variable_domain.size(), false);
+    for (const PropositionalAxiom &axiom : g_logic_axioms) {
+        for (const GlobalCondition &cond : axiom.get_preconditions())
+            is_logic_axiom_input[cond.var] = true;
+    }
+    arithmetic_is_queued.assign(g_ass_axioms.size(), false);
+    comparison_is_queued.assign(g_comp_axioms.size(), false);
+}
+
+void AxiomEvaluator::evaluate_arithmetic_axioms(vector<ap_float> &numeric_state) {
+    assert(g_numeric_var_names.size() == numeric_state.size());
+    const int *lhs = arithmetic_axioms.lhs.data();
+    const int *rhs = arithmetic_axioms.rhs.data();
+    const int *affected_var = arithmetic_axioms.affected_var.data();
+    ap_float *values = numeric_state.data();
+    for (const CompiledAxioms::Group &group : arithmetic_axioms.groups) {
+        switch (group.op) {
+        case sum:
+            evaluate_arithmetic_group(lhs, rhs, affected_var, group.begin, group.end,
+                                      values, plus<ap_float>());
+            break;
+        case diff:
+            evaluate_arithmetic_group(lhs, rhs, affected_var, group.begin, group.end,
+                                      values, minus<ap_float>());
+            break;
+        case mult:
+            evaluate_arithmetic_group(lhs, rhs, affected_var, group.begin, group.end,
+                                      values, multiplies<ap_float>());
+            break;
+        case divi:
+            evaluate_arithmetic_group(lhs, rhs, affected_var, group.begin, group.end,
+                                      values, divides<ap_float>());
+            break;
+        default:
+            cout << "Error: No assignment operators are allowed here." << endl;
+            assert(false);
+            break;
+        }
+    }
 }
 
-void AxiomEvaluator::evaluate_comparison_axioms(PackedStateBin *buffer, vector<ap_float> &numeric_state)
-{
-	for(const auto & ax : g_comp_axioms) {
-		int var = ax.affected_variable; // logic variable
-		assert(ax.var_lhs < (int) numeric_state.size());
-		assert(ax.var_rhs < (int) numeric_state.size());
-		ap_float left = numeric_state[ax.var_lhs];
-		ap_float right = numeric_state[ax.var_rhs];
-        bool result;
-//        cout << "evaluating comparison axiom: " << endl;
-//if(DEBUG) cout << g_variable_name[ax->affected_variable] << " := " << g_numeric_var_names[ax->var_lhs] << " " << ax->op << " " <<g_numeric_var_names[ax->var_rhs];
-        switch(ax.op) {
+void AxiomEvaluator::compute_comparison_results(const vector<ap_float> &numeric_state) {
+    const int *lhs = comparison_axioms.lhs.data();
+    const int *rhs = comparison_axioms.rhs.data();
+    const ap_float *values = numeric_state.data();
+    char *results = comparison_results.data();
+    for (const CompiledAxioms::Group &group : comparison_axioms.groups) {
+        switch (group.op) {
         case lt:
-        	result = left < right;
-        	break;
+            evaluate_comparison_group(lhs, rhs, group.begin, group.end, values,
+                                      results, less<ap_float>());
+            break;
         case le:
-        	result = left <= right;
-        	break;
+            evaluate_comparison_group(lhs, rhs, group.begin, group.end, values,
+                                      results, less_equal<ap_float>());
+            break;
         case eq:
-        	result = left == right;
-        	break;
+            evaluate_comparison_group(lhs, rhs, group.begin, group.end, values,
+                                      results, equal_to<ap_float>());
+            break;
         case ge:
-        	result = left >= right;
-        	break;
+            evaluate_comparison_group(lhs, rhs, group.begin, group.end, values,
+                                      results, greater_equal<ap_float>());
+            break;
         case gt:
-        	result = left > right;
-        	break;
+            evaluate_comparison_group(lhs, rhs, group.begin, group.end, values,
+                                      results, greater<ap_float>());
+            break;
         case ue:
-        	result = left != right;
-        	break;
+            evaluate_comparison_group(lhs, rhs, group.begin, group.end, values,
+                                      results, not_equal_to<ap_float>());
+            break;
         default:
-        	cout << "Error: No comparison operators are allowed here." << endl;
-        	assert(false);
-        	result = false;
-        	break;
+            cout << "Error: No comparison operators are allowed here." << endl;
+            assert(false);
+            break;
         }
-//        cout << " => var "<< var << " = " << (result?0:1) << endl;
-    	g_state_packer->set(buffer,var,(result?0:1));
-	}
+    }
 }
 
-void AxiomEvaluator::evaluate_comparison_axioms(vector<int> &state, vector<ap_float> &numeric_state)
-{
-    for(const auto & ax : g_comp_axioms) {
-        int var = ax.affected_variable; // logic variable
-        assert(ax.var_lhs < (int) numeric_state.size());
-        assert(ax.var_rhs < (int) numeric_state.size());
-        ap_float left = numeric_state[ax.var_lhs];
-        ap_float right = numeric_state[ax.var_rhs];
-        bool result;
-//        cout << "evaluating comparison axiom: " << endl;
-//if(DEBUG) cout << g_variable_name[ax->affected_variable] << " := " << g_numeric_var_names[ax->var_lhs] << " " << ax->op << " " <<g_numeric_var_names[ax->var_rhs];
-        switch(ax.op) {
-            case lt:
-                result = left < right;
-                break;
-            case le:
-                result = left <= right;
-                break;
-            case eq:
-                result = left == right;
-                break;
-            case ge:
-                result = left >= right;
-                break;
-            case gt:
-                result = left > right;
-                break;
-            case ue:
-                result = left != right;
-                break;
-            default:
-                cout << "Error: No comparison operators are allowed here." << endl;
-                assert(false);
-                result = false;
-                break;
+void AxiomEvaluator::evaluate_comparison_axioms(PackedStateBin *buffer, vector<ap_float> &numeric_state) {
+    compute_comparison_results(numeric_state);
+    const vector<int> &affected_var = comparison_axioms.affected_var;
+    for (size_t i = 0; i < affected_var.size(); ++i) {
+        // The value 0 of a comparison variable means that the comparison holds.
+        g_state_packer->set(buffer, affected_var[i], comparison_results[i] ? 0 : 1);
+    }
+}
+
+void AxiomEvaluator::evaluate_comparison_axioms(vector<int> &state, vector<ap_float> &numeric_state) {
+    compute_comparison_results(numeric_state);
+    const vector<int> &affected_var = comparison_axioms.affected_var;
+    for (size_t i = 0; i < affected_var.size(); ++i)
+        state[affected_var[i]] = comparison_results[i] ? 0 : 1;
+}
+
+void AxiomEvaluator::evaluate_incrementally(PackedStateBin *buffer,
+                                            vector<ap_float> &numeric_state,
+                                            const vector<int> &changed_numeric_vars,
+                                            const vector<int> &changed_logic_vars) {
+    assert(g_numeric_var_names.size() == numeric_state.size());
+    assert(arithmetic_queue.empty());
+    ++num_incremental_evaluations;
+
+    /*
+      Readers of a variable are in a higher layer than its writer, so
+      processing the queued arithmetic axioms in the order of their positions
+      evaluates every axiom after all of its inputs.
+    */
+    affected_numeric_vars.clear();
+    auto add_affected = [&](int var) {
+        affected_numeric_vars.push_back(var);
+        for (int pos : arithmetic_axioms.axioms_by_input[var]) {
+            if (!arithmetic_is_queued[pos]) {
+                arithmetic_is_queued[pos] = true;
+                arithmetic_queue.push_back(pos);
+                push_heap(arithmetic_queue.begin(), arithmetic_queue.end(), greater<int>());
+            }
+        }
+    };
+    for (int var : changed_numeric_vars)
+        add_affected(var);
+    while (!arithmetic_queue.empty()) {
+        pop_heap(arithmetic_queue.begin(), arithmetic_queue.end(), greater<int>());
+        int pos = arithmetic_queue.back();
+        arithmetic_queue.pop_back();
+        arithmetic_is_queued[pos] = false;
+        int var = arithmetic_axioms.affected_var[pos];
+        ap_float result = apply_cal_operator(
+            arithmetic_axioms.op[pos],
+            numeric_state[arithmetic_axioms.lhs[pos]],
+            numeric_state[arithmetic_axioms.rhs[pos]]);
+        if (result != numeric_state[var]) {
+            numeric_state[var] = result;
+            add_affected(var);
         }
-//        cout << " => var "<< var << " = " << (result?0:1) << endl;
-        state[var] = (result?0:1);
+    }
+
+    queued_comparisons.clear();
+    for (int var : affected_numeric_vars) {
+        for (int pos : comparison_axioms.axioms_by_input[var]) {
+            if (!comparison_is_queued[pos]) {
+                comparison_is_queued[pos] = true;
+                queued_comparisons.push_back(pos);
+            }
+        }
+    }
+    bool logic_input_changed = false;
+    for (int pos : queued_comparisons) {
+        comparison_is_queued[pos] = false;
+        int var = comparison_axioms.affected_var[pos];
+        bool result = apply_comp_operator(
+            comparison_axioms.op[pos],
+            numeric_state[comparison_axioms.lhs[pos]],
+            numeric_state[comparison_axioms.rhs[pos]]);
+        container_int value = result ? 0 : 1;
+        if (g_state_packer->get(buffer, var) != value) {
+            g_state_packer->set(buffer, var, value);
+            if (is_logic_axiom_input[var])
+                logic_input_changed = true;
+        }
+    }
+
+    if (!has_logic_axioms())
+        return;
+    for (int var : changed_logic_vars) {
+        if (is_logic_axiom_input[var]) {
+            logic_input_changed = true;
+            break;
+        }
+    }
+    /*
+      The derived variables of the parent are the least fixpoint of the logic
+      axioms for the inputs of the parent, so they can be reused if no input
+      changed.
+    */
+    if (logic_input_changed) {
+        ++num_logic_evaluations;
+        evaluate_logic_axioms(buffer);
+    }
+}
+
+void AxiomEvaluator::print_statistics() const {
+    if (num_incremental_evaluations > 0 && has_logic_axioms()) {
+        cout << "Successors with logic axiom evaluation: " << num_logic_evaluations
+             << " of " << num_incremental_evaluations << endl;
     }
 }
 
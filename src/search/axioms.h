@@ -27,7 +27,7 @@ class PropositionalAxiom : public Axiom
         std::vector<GlobalCondition> conditions; // var, val
         std::vector<GlobalEffect> effects; // this vector will only have one element (if initialized) nevertheless it is more convenient to use a vector to better reuse code that treats operators and axioms alike
 
-        PropositionalAxiom(std::istream &in);
+        PropositionalAxiom(TaskReader &in);
         void dump() const;
 
         const std::vector<GlobalCondition> &get_preconditions() const {return conditions; }
@@ -50,7 +50,7 @@ class ComparisonAxiom : public Axiom
         int var_rhs;
         comp_operator op;
 
-        ComparisonAxiom(std::istream &in);
+        ComparisonAxiom(TaskReader &in);
 
         void dump() const;
 };
@@ -62,7 +62,7 @@ class AssignmentAxiom : public Axiom
         int var_rhs; // index of numeric right hand side variable
         cal_operator op;
 
-        AssignmentAxiom(std::istream &in);
+        AssignmentAxiom(TaskReader &in);
 
         void dump() const;
 };
@@ -98,7 +98,50 @@ class AxiomEvaluator {
     // The queue is an instance variable rather than a local variable
     // to reduce reallocation effort. See issue420.
     std::vector<AxiomLiteral *> queue;
-private:
+
+    /*
+      The arithmetic and comparison axioms are compiled into flat arrays
+      (structure of arrays) once at startup. The axioms are ordered by layer
+      and, within a layer, grouped by operator. Each group is evaluated by a
+      loop that does not dispatch on the operator per axiom, and since axioms
+      of the same layer do not depend on each other, the iterations of such a
+      loop are independent (and can be vectorized by the compiler). All
+      comparison axioms form a single layer.
+    */
+    struct CompiledAxioms {
+        struct Group {
+            int begin;
+            int end;
+            int op; // cal_operator or comp_operator
+        };
+        std::vector<int> lhs;
+        std::vector<int> rhs;
+        std::vector<int> affected_var;
+        std::vector<int> op;
+        std::vector<Group> groups;
+        // Positions of the axioms that read a given numeric variable.
+        std::vector<std::vector<int>> axioms_by_input;
+    };
+    CompiledAxioms arithmetic_axioms;
+    CompiledAxioms comparison_axioms;
+    // Results of the comparison axioms (before they are written to the state).
+    std::vector<char> comparison_results;
+    // True for the propositional variables occurring in the body of a logic axiom.
+    std::vector<char> is_logic_axiom_input;
+
+    // Scratch space for evaluate_incrementally.
+    std::vector<int> arithmetic_queue; // min-heap of positions
+    std::vector<char> arithmetic_is_queued;
+    std::vector<char> comparison_is_queued;
+    std::vector<int> queued_comparisons;
+    std::vector<int> affected_numeric_vars;
+
+    // Statistics.
+    long long num_incremental_evaluations;
+    long long num_logic_evaluations;
+
+    void compile_numeric_axioms();
+    void compute_comparison_results(const std::vector<ap_float> &numeric_state);
     void evaluate_comparison_axioms(PackedStateBin *buffer, std::vector<ap_float> &numeric_state);
     void evaluate_comparison_axioms(std::vector<int> &state, std::vector<ap_float> &numeric_state);
     void evaluate_logic_axioms(PackedStateBin *buffer);
@@ -108,6 +151,21 @@ public:
     void evaluate(PackedStateBin *buffer, std::vector<ap_float> &numeric_state);
     void evaluate(std::vector<int> &state, std::vector<ap_float> &numeric_state);
     void evaluate_arithmetic_axioms(std::vector<ap_float> &numeric_state);
+
+    /*
+      Evaluates all axioms in a successor state, assuming that buffer and
+      numeric_state contain the values of the parent state (including derived
+      values), except for the variables in changed_numeric_vars and
+      changed_logic_vars. Only the axioms that (transitively) depend on these
+      variables are re-evaluated. Logic axioms are evaluated all at once, and
+      only if one of their inputs changed.
+    */
+    void evaluate_incrementally(PackedStateBin *buffer,
+                                std::vector<ap_float> &numeric_state,
+                                const std::vector<int> &changed_numeric_vars,
+                                const std::vector<int> &changed_logic_vars);
+
+    void print_statistics() const;
 };
 
 #endif
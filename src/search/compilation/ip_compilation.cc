@@ -2,6 +2,9 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include <algorithm>
+#include <cassert>
+
 using namespace std;
 using namespace ip_compilation;
 
@@ -24,6 +27,61 @@ void IPCompilation::initialize(int t) {
         generator->initialize_constraints(task, constraints, infinity);
     }
     lp_solver.load_problem(lp::LPObjectiveSense::MINIMIZE, variables, constraints);
+    num_loaded_variables = variables.size();
+    num_loaded_constraints = constraints.size();
+}
+
+void IPCompilation::extend_model() {
+    delete_replaced_constraints();
+    lp_solver.add_variables(vector<lp::LPVariable>(
+        variables.begin() + num_loaded_variables, variables.end()));
+    lp_solver.add_permanent_constraints(vector<lp::LPConstraint>(
+        constraints.begin() + num_loaded_constraints, constraints.end()));
+    num_loaded_variables = variables.size();
+    num_loaded_constraints = constraints.size();
+}
+
+void IPCompilation::delete_replaced_constraints() {
+    vector<int> replaced;
+    for (auto generator : constraint_generators) {
+        const vector<int> &indices = generator->get_replaced_constraints();
+        replaced.insert(replaced.end(), indices.begin(), indices.end());
+        generator->clear_replaced_constraints();
+    }
+    if (replaced.empty())
+        return;
+    sort(replaced.begin(), replaced.end());
+    assert(replaced.front() >= 0);
+
+    /*
+      After a dead end, a constraint may have been replaced before it was
+      loaded. Such constraints are only removed from constraints.
+    */
+    vector<int> loaded_rows(
+        replaced.begin(),
+        lower_bound(replaced.begin(), replaced.end(),
+                    static_cast<int>(num_loaded_constraints)));
+    lp_solver.delete_permanent_constraints(loaded_rows);
+    num_loaded_constraints -= loaded_rows.size();
+
+    vector<int> new_index(constraints.size(), -1);
+    size_t num_kept = 0;
+    size_t next_replaced = 0;
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        if (next_replaced < replaced.size() &&
+            replaced[next_replaced] == static_cast<int>(i)) {
+            ++next_replaced;
+        } else {
+            new_index[i] = num_kept;
+            if (num_kept != i)
+                constraints[num_kept] = move(constraints[i]);
+            ++num_kept;
+        }
+    }
+    constraints.erase(constraints.begin() + num_kept, constraints.end());
+    for (auto generator : constraint_generators) {
+        generator->remap_constraint_indices(new_index);
+    }
 }
 
 ap_float IPCompilation::get_min_action_cost(){
@@ -66,7 +124,7 @@ ap_float IPCompilation::compute_plan(const int horizon, const double time){
     }
     cout << "updating " << horizon << " remaining time " << time << endl;
     lp_solver.clear_temporary_constraints();
-    lp_solver.load_problem(lp::LPObjectiveSense::MINIMIZE, variables, constraints);
+    extend_model();
     
     ap_float result;
     lp_solver.set_time_limit(time);
@@ -34,6 +34,21 @@ namespace ip_compilation{
         const std::shared_ptr<AbstractTask> task;
         std::vector<lp::LPVariable> variables;
         std::vector<lp::LPConstraint> constraints;
+        
+        /*
+          The model of a horizon extends the model of the previous one. Only
+          the variables and constraints after these positions are new and
+          passed to the solver, which keeps its basis.
+        */
+        size_t num_loaded_variables = 0;
+        size_t num_loaded_constraints = 0;
+        void extend_model();
+        /*
+          Goal and landmark constraints refer to the last time step and are
+          replaced for every horizon. The replaced rows are deleted from the
+          solver, so the model does not keep one dead row per horizon.
+        */
+        void delete_replaced_constraints();
 
     };
     
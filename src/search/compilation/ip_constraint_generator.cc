@@ -9,11 +9,31 @@
 #include "sb_compilation.h"
 #include "ip_constraint_generator.h"
 
+#include <cassert>
+
 using namespace std;
 using namespace operator_counting;
 using namespace numeric_helper;
 
 
+int IPConstraintGenerator::replace_constraint(vector<lp::LPConstraint> &constraints,
+                                              int index, const lp::LPConstraint &constraint) {
+    assert(index >= 0 && index < static_cast<int>(constraints.size()));
+    replaced_constraints.push_back(index);
+    constraints.push_back(constraint);
+    return constraints.size() - 1;
+}
+
+void IPConstraintGenerator::remap_indices(vector<int> &indices,
+                                          const vector<int> &new_index) {
+    for (int &index : indices) {
+        if (index != -1) {
+            index = new_index[index];
+            assert(index != -1);
+        }
+    }
+}
+
 void IPConstraintGenerator::print_solution(vector<double> &solution,const std::shared_ptr<AbstractTask> task){
     TaskProxy task_proxy(*task);
     OperatorsProxy ops = task_proxy.get_operators();
@@ -27,11 +27,45 @@ namespace operator_counting {
             t_min = t;
         }
         
+        /*
+          Returns the indices of the constraints that were replaced by
+          replace_constraint since the last call of clear_replaced_constraints.
+        */
+        const std::vector<int> &get_replaced_constraints() const {
+            return replaced_constraints;
+        }
+        
+        void clear_replaced_constraints() {
+            replaced_constraints.clear();
+        }
+        
+        /*
+          Called after IPCompilation deleted replaced constraints. new_index
+          maps each old constraint index to its new index, or to -1 if the
+          constraint was deleted. Generators that store constraint indices
+          must update them here.
+        */
+        virtual void remap_constraint_indices(const std::vector<int> &/*new_index*/) {}
+        
     protected:
         
         std::vector<std::vector<int>> *index_opt;
         int t_max = 0;
         int t_min = 0;
+        std::vector<int> replaced_constraints;
+        
+        /*
+          Replaces the constraint with the given index by a new constraint
+          at the end of constraints and returns the new index. The solver
+          model is only extended between horizons, so the old constraint
+          is deleted by IPCompilation before the new one is loaded.
+        */
+        int replace_constraint(std::vector<lp::LPConstraint> &constraints,
+                               int index, const lp::LPConstraint &constraint);
+        
+        // Applies new_index to all entries of indices that are not -1.
+        static void remap_indices(std::vector<int> &indices,
+                                  const std::vector<int> &new_index);
         
     };
 }
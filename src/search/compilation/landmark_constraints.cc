@@ -52,6 +52,10 @@ bool LandmarkConstraints::update_constraints(const int horizon,
     return false;
 }
 
+void LandmarkConstraints::remap_constraint_indices(const vector<int> &new_index) {
+    remap_indices(landmark_constraints_index, new_index);
+}
+
 void LandmarkConstraints::landmark_constraints(const std::shared_ptr<AbstractTask> task,
                                                      std::vector<lp::LPConstraint> &constraints,
                                                      double infinity, int t_max){
@@ -66,7 +70,8 @@ void LandmarkConstraints::landmark_constraints(const std::shared_ptr<AbstractTas
             landmark_constraints_index[id]= constraints.size();
             constraints.push_back(constraint);
         }else{
-            constraints[landmark_constraints_index[id]] = constraint;
+            landmark_constraints_index[id] = replace_constraint(
+                constraints, landmark_constraints_index[id], constraint);
         }
         ++id;
     }
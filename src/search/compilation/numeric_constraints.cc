@@ -93,6 +93,10 @@ bool NumericConstraints::update_constraints(
   return false;
 }
 
+void NumericConstraints::remap_constraint_indices(const vector<int> &new_index) {
+  remap_indices(goal_index, new_index);
+}
+
 void NumericConstraints::initial_state_constraint(
     const std::shared_ptr<AbstractTask> task,
     std::vector<lp::LPConstraint> &constraints) {
@@ -230,8 +234,7 @@ void NumericConstraints::goal_state_constraint(
     const std::shared_ptr<AbstractTask> task,
     std::vector<lp::LPConstraint> &constraints, double infinity, int t_max) {
   TaskProxy task_proxy(*task);
-  static bool first = goal_index.empty();
-  if (first) {
+  if (goal_index.empty()) {
     int n_goals = 0;
     for (size_t id_goal = 0; id_goal < numeric_task.get_n_numeric_goals();
          ++id_goal) {
@@ -260,17 +263,17 @@ void NumericConstraints::goal_state_constraint(
         constraint.insert(index_numeric_var[n_id][t_max - 1], coefficient);
       }
       if (!constraint.empty()) {
-        if (first) {
+        if (goal_index[i_goal] == -1) {
           goal_index[i_goal] = constraints.size();
           constraints.push_back(constraint);
         } else {
-          constraints[goal_index[i_goal]] = constraint;
+          goal_index[i_goal] =
+              replace_constraint(constraints, goal_index[i_goal], constraint);
         }
       }
       i_goal++;
     }
   }
-  if (first) first = false;
 }
 
 void NumericConstraints::initialize_numeric_mutex() {
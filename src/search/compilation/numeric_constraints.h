@@ -22,6 +22,7 @@ class NumericConstraints : public IPConstraintGenerator {
                                   std::vector<lp::LPVariable> &variables,
                                   double infinity,
                                   std::vector<lp::LPConstraint> &constraints);
+  virtual void remap_constraint_indices(const std::vector<int> &new_index);
 
  private:
   std::vector<std::vector<int>> index_numeric_var;
@@ -189,6 +189,10 @@ bool SASStateChangeModel::update_constraints(
   return false;
 }
 
+void SASStateChangeModel::remap_constraint_indices(const vector<int> &new_index) {
+  remap_indices(goal_index, new_index);
+}
+
 void SASStateChangeModel::initial_state_constraint(
     const std::shared_ptr<AbstractTask> task,
     std::vector<lp::LPConstraint> &constraints) {
@@ -244,7 +248,8 @@ void SASStateChangeModel::goal_state_constraint(
         goal_index[id_goal] = constraints.size();
         constraints.push_back(constraint);
       } else {
-        constraints[goal_index[id_goal]] = constraint;
+        goal_index[id_goal] =
+            replace_constraint(constraints, goal_index[id_goal], constraint);
       }
     }
   }
@@ -23,6 +23,7 @@ class SASStateChangeModel : public IPConstraintGenerator {
                                   std::vector<lp::LPVariable> &variables,
                                   double infinity,
                                   std::vector<lp::LPConstraint> &constraints);
+  virtual void remap_constraint_indices(const std::vector<int> &new_index);
 
  private:
   // std::vector<vector<int>> index_opt;
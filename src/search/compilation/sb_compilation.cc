@@ -123,6 +123,10 @@ bool StateBasedModel::update_constraints(const int horizon,
     return false;
 }
 
+void StateBasedModel::remap_constraint_indices(const vector<int> &new_index) {
+    remap_indices(goal_index, new_index);
+}
+
 void StateBasedModel::initial_state_constraint(const std::shared_ptr<AbstractTask> task,
                                                std::vector<lp::LPConstraint> &constraints){
     
@@ -261,7 +265,7 @@ void StateBasedModel::goal_state_constraint(const std::shared_ptr<AbstractTask>
                 goal_index[id_goal]= constraints.size();
                 constraints.push_back(constraint);
             }else{
-                constraints[goal_index[id_goal]] = constraint;
+                goal_index[id_goal] = replace_constraint(constraints, goal_index[id_goal], constraint);
             }
         }
     }
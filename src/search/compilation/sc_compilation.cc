@@ -191,6 +191,10 @@ bool StateChangeModel::update_constraints(const int horizon,
     return false;
 }
 
+void StateChangeModel::remap_constraint_indices(const vector<int> &new_index) {
+    remap_indices(goal_index, new_index);
+}
+
 void StateChangeModel::initial_state_constraint(const std::shared_ptr<AbstractTask> task,
                                                std::vector<lp::LPConstraint> &constraints){
     
@@ -247,7 +251,7 @@ void StateChangeModel::goal_state_constraint(const std::shared_ptr<AbstractTask>
                 goal_index[id_goal]= constraints.size();
                 constraints.push_back(constraint);
             }else{
-                constraints[goal_index[id_goal]] = constraint;
+                goal_index[id_goal] = replace_constraint(constraints, goal_index[id_goal], constraint);
             }
         }
     }
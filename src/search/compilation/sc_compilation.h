@@ -24,6 +24,7 @@ namespace operator_counting {
                                         lp::LPSolver &lp_solver,const std::shared_ptr<AbstractTask> task,
                                         std::vector<lp::LPVariable> &variables,
                                         double infinity,std::vector<lp::LPConstraint> & constraints);
+        virtual void remap_constraint_indices(const std::vector<int> &new_index);
     private:
         //std::vector<std::vector<int>> index_opt;
         std::vector<std::vector<int>> index_a;
@@ -7,6 +7,7 @@
 #include "globals.h"
 #include "state_registry.h" // g_state_registry has to be accessed by set_cost
 #include "axioms.h" // convert_from_axiom requires this
+#include "task_reader.h"
 
 #include <algorithm>
 #include <cassert>
@@ -27,7 +28,7 @@ static void check_fact(int var, container_int val) {
     }
 }
 
-GlobalCondition::GlobalCondition(istream &in) {
+GlobalCondition::GlobalCondition(TaskReader &in) {
 	var = -1; val = -1;
     in >> var >> val;
     check_fact(var, val);
@@ -39,7 +40,7 @@ GlobalCondition::GlobalCondition(int variable, int value)
     check_fact(var, val);
 }
 
-AssignEffect::AssignEffect(istream &in) {
+AssignEffect::AssignEffect(TaskReader &in) {
 	aff_var = -1;
 	ass_var = -1;
 	fop = assign;
@@ -70,7 +71,7 @@ GlobalEffect::GlobalEffect(int variable, container_int value, const vector<Globa
     check_fact(var, val);
 }
 
-void GlobalOperator::read_pre_post(istream &in) {
+void GlobalOperator::read_pre_post(TaskReader &in) {
     int cond_count, var, pre, post;
     in >> cond_count;
     vector<GlobalCondition> conditions;
@@ -86,7 +87,7 @@ void GlobalOperator::read_pre_post(istream &in) {
     effects.push_back(GlobalEffect(var, post, conditions));
 }
 
-GlobalOperator::GlobalOperator(istream &in, bool axiom) {
+GlobalOperator::GlobalOperator(TaskReader &in, bool axiom) {
     marked = false;
 
     is_an_axiom = axiom;
@@ -6,10 +6,12 @@
 #include <string>
 #include <vector>
 
+class TaskReader;
+
 struct GlobalCondition {
     int var;
     container_int val;
-    explicit GlobalCondition(std::istream &in);
+    explicit GlobalCondition(TaskReader &in);
     GlobalCondition(int variable, int value);
 
     bool is_applicable(const GlobalState &state) const {
@@ -31,7 +33,7 @@ struct GlobalEffect {
     int var;
     container_int val;
     std::vector<GlobalCondition> conditions;
-    explicit GlobalEffect(std::istream &in);
+    explicit GlobalEffect(TaskReader &in);
     GlobalEffect(int variable, container_int value, const std::vector<GlobalCondition> &conds);
 
     bool does_fire(const GlobalState &state) const {
@@ -49,7 +51,7 @@ struct AssignEffect {
 	int ass_var;
 	bool is_conditional_effect;
 	std::vector<GlobalCondition> conditions;
-	AssignEffect(std::istream &in);
+	AssignEffect(TaskReader &in);
 	AssignEffect(int v, f_operator fotor, int a) :
 		aff_var(v), fop(fotor), ass_var(a) {
 		is_conditional_effect = false;
@@ -66,9 +68,9 @@ class GlobalOperator {
     std::string name;
     ap_float cost;
     mutable bool marked; // Used for short-term marking of preferred operators
-    void read_pre_post(std::istream &in);
+    void read_pre_post(TaskReader &in);
 public:
-    explicit GlobalOperator(std::istream &in, bool is_axiom);
+    explicit GlobalOperator(TaskReader &in, bool is_axiom);
     explicit GlobalOperator(PropositionalAxiom convert_from_axiom);
     void dump() const;
     const std::string &get_name() const {return name; }
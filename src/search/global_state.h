@@ -19,6 +19,7 @@ class GlobalState {
     friend class StateRegistry;
     template<typename Entry>
     friend class PerStateInformation;
+    friend class PerStateBitset;
     // Values for vars are maintained in a packed state and accessed on demand.
     const PackedStateBin *buffer;
     // registry isn't a reference because we want to support operator=
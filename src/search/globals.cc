@@ -6,9 +6,10 @@
 #include "global_state.h"
 #include "heuristic.h"
 #include "int_packer.h"
+#include "numeric_encoding.h"
 #include "state_registry.h"
 #include "successor_generator.h"
-#include "per_state_information.h" // instrumentation variables are stored as PSI
+#include "task_reader.h"
 
 #include "tasks/root_task.h"
 
@@ -89,7 +90,7 @@ void save_plan(const vector<const GlobalOperator *> &plan,
     ++g_num_previously_generated_plans;
 }
 
-void check_magic(istream &in, string magic) {
+void check_magic(TaskReader &in, string magic) {
     string word;
     in >> word;
     if (word != magic) {
@@ -104,7 +105,7 @@ void check_magic(istream &in, string magic) {
     }
 }
 
-void read_and_verify_version(istream &in) {
+void read_and_verify_version(TaskReader &in) {
     int version;
     check_magic(in, "begin_version");
     in >> version;
@@ -117,7 +118,7 @@ void read_and_verify_version(istream &in) {
     }
 }
 
-void read_metric(istream &in) {
+void read_metric(TaskReader &in) {
     check_magic(in, "begin_metric");
     char optimization;
     in >> optimization;
@@ -133,7 +134,7 @@ void read_metric(istream &in) {
     check_magic(in, "end_metric");
 }
 
-void read_variables(istream &in) {
+void read_variables(TaskReader &in) {
     int count;
     in >> count;
     for (int i = 0; i < count; ++i) {
@@ -156,7 +157,7 @@ void read_variables(istream &in) {
     }
 }
 
-void read_numeric_variables(istream &in) {
+void read_numeric_variables(TaskReader &in) {
     int count;
     in >> count;
     if (DEBUG) cout << "Domain has " << count << " numeric variables " << endl;
@@ -179,7 +180,7 @@ void read_numeric_variables(istream &in) {
 }
 
 
-void read_mutexes(istream &in) {
+void read_mutexes(TaskReader &in) {
     g_inconsistent_facts.resize(g_variable_domain.size());
     for (size_t i = 0; i < g_variable_domain.size(); ++i)
         g_inconsistent_facts[i].resize(g_variable_domain[i]);
@@ -229,7 +230,7 @@ void read_mutexes(istream &in) {
     }
 }
 
-void read_goal(istream &in) {
+void read_goal(TaskReader &in) {
     check_magic(in, "begin_goal");
     int count;
     in >> count;
@@ -245,7 +246,7 @@ void read_goal(istream &in) {
     check_magic(in, "end_goal");
 }
 
-void read_global_constraint(istream &in) {
+void read_global_constraint(TaskReader &in) {
     check_magic(in, "begin_global_constraint");
     in >> g_global_constraint_var_id >> g_global_constraint_val;
     check_magic(in, "end_global_constraint");
@@ -258,7 +259,7 @@ void dump_goal() {
              << g_goal[i].second << endl;
 }
 
-void read_operators(istream &in) {
+void read_operators(TaskReader &in) {
     int count;
     in >> count;
     for (int i = 0; i < count; ++i)
@@ -287,7 +288,7 @@ void read_operators(istream &in) {
 //}
 
 
-void read_axioms(istream &in) {
+void read_axioms(TaskReader &in) {
     int count;
     in >> count;
     if(DEBUG) cout << "Reading " << count << " propositional axioms " << endl;
@@ -331,8 +332,9 @@ void read_axioms(istream &in) {
     g_axiom_evaluator = new AxiomEvaluator; // requires the sizes of all axioms, do not call earlier
 }
 
-void read_everything(istream &in) {
+void read_everything(istream &input) {
     cout << "reading input... [t=" << utils::g_timer << "]" << endl;
+    TaskReader in(input);
     read_and_verify_version(in);
     read_metric(in);
     read_variables(in);
@@ -393,13 +395,12 @@ void read_everything(istream &in) {
 	 Note that in order to have 64 bit precision floats a.k.a "double"
 	 the container_int type has to be an unsigned 64 bit int (unsigned long long)
 
-	 we only reserve space for non-constant non-instrumentation vars
-	 TODO: currently derived variables are stored in the state. If this is changed for regular variables, numeric variables should change as well
+	 we only reserve space for regular variables (derived variables are
+	 evaluated on the fly). Their encoding is determined by NumericEncoding.
 	 */
-    int regular_variables = g_numeric_var_names.size() - numeric_constants - instrumentation_vars;
-    if (DEBUG) cout << "Task has " << regular_variables << " regular (or derived)  variables." << endl;
-    assert(regular_variables >= 0);
-    statespace_sizes.resize(statespace_sizes.size()+regular_variables, numeric_limits<container_int>::max());
+    g_numeric_encoding = new NumericEncoding();
+    g_numeric_encoding->append_ranges(statespace_sizes);
+    if (DEBUG) cout << "Task has " << statespace_sizes.size() - g_variable_domain.size() << " regular variables." << endl;
 //    cout << "initializing state packer ..." << endl;
     g_state_packer = new IntPacker(statespace_sizes);
     cout << "done! [t=" << utils::g_timer << "]" << endl;
@@ -428,6 +429,7 @@ void read_everything(istream &in) {
     cout << "Bytes per state: "
          << g_state_packer->get_num_bins() *
         g_state_packer->get_bin_size_in_bytes() << endl;
+    g_numeric_encoding->dump_statistics();
 
     cout << "Building successor generator..." << flush;
     g_successor_generator = new SuccessorGenerator(g_root_task());
@@ -566,6 +568,7 @@ vector<int> g_axiom_layers; // [i] stores the axiom layer of i-th variable
 vector<int> g_numeric_axiom_layers; // [i] stores the axiom layer of i-th numeric variables
 vector<container_int> g_default_axiom_values;
 IntPacker *g_state_packer;
+NumericEncoding *g_numeric_encoding;
 vector<container_int> g_initial_state_data;
 vector<ap_float> g_initial_state_numeric;
 vector<pair<int, container_int> > g_goal;
@@ -578,6 +581,7 @@ int g_global_constraint_var_id;
 int g_global_constraint_val;
 
 AxiomEvaluator *g_axiom_evaluator;
+static thread_local AxiomEvaluator *thread_axiom_evaluator = nullptr;
 SuccessorGenerator *g_successor_generator;
 int g_last_arithmetic_axiom_layer;
 int g_comparison_axiom_layer;
@@ -588,7 +592,7 @@ string g_plan_filename = "sas_plan";
 int g_num_previously_generated_plans = 0;
 bool g_is_part_of_anytime_portfolio = false;
 StateRegistry *g_state_registry = 0;
-PerStateInformation<std::vector<ap_float> > g_cost_information;
+bool g_use_open_addressing = false;
 
 //TODO: the loggers should be managed in the same class
 utils::Log g_log;
@@ -840,3 +844,11 @@ cal_operator get_inverse_op(cal_operator cop) {
 
 // Globals for symmetries
 GraphCreator* g_symmetry_graph = nullptr;
+
+AxiomEvaluator &get_thread_axiom_evaluator() {
+    return thread_axiom_evaluator ? *thread_axiom_evaluator : *g_axiom_evaluator;
+}
+
+void set_thread_axiom_evaluator(AxiomEvaluator *axiom_evaluator) {
+    thread_axiom_evaluator = axiom_evaluator;
+}
@@ -23,7 +23,9 @@ class StateRegistry;
 class GlobalOperator;
 class GlobalState;
 class IntPacker;
+class NumericEncoding;
 class SuccessorGenerator;
+class TaskReader;
 
 class GraphCreator;
 
@@ -33,7 +35,6 @@ class PlanVisLogger;
 class RandomNumberGenerator;
 }
 
-template<class Entry> class PerStateInformation;
 
 // TODO: the encoding size of floats has to be determined by command line
 // a container_int has to be an integer variable with the same encoding size as ap_float
@@ -77,7 +78,7 @@ bool has_conditional_effects();
 void verify_no_conditional_effects();
 void verify_no_axioms_no_conditional_effects();
 
-void check_magic(std::istream &in, std::string magic);
+void check_magic(TaskReader &in, std::string magic);
 
 bool are_mutex(const Fact &a, const Fact &b);
 std::list<std::set<Fact>> get_mutex_group();
@@ -136,6 +137,7 @@ extern std::vector<std::string> g_numeric_var_names;
 extern std::vector<numType> g_numeric_var_types;
 
 extern IntPacker *g_state_packer;
+extern NumericEncoding *g_numeric_encoding;
 // This vector holds the initial values *before* the axioms have been evaluated.
 // Use the state registry to obtain the real initial state.
 extern std::vector<container_int> g_initial_state_data;
@@ -158,6 +160,14 @@ extern std::vector<AssignmentAxiom> g_ass_axioms;
 extern int g_global_constraint_var_id;
 extern int g_global_constraint_val;
 extern AxiomEvaluator *g_axiom_evaluator;
+/*
+  Axiom evaluator for code that is not tied to a state registry, such as
+  State::get_successor. This is g_axiom_evaluator unless the calling thread
+  set its own: evaluators have scratch data, so threads that run in
+  parallel must not share one (see ParallelEagerSearch).
+*/
+extern AxiomEvaluator &get_thread_axiom_evaluator();
+extern void set_thread_axiom_evaluator(AxiomEvaluator *axiom_evaluator);
 extern SuccessorGenerator *g_successor_generator;
 extern std::string g_plan_filename;
 extern int g_num_previously_generated_plans;
@@ -167,7 +177,9 @@ extern std::shared_ptr<utils::RandomNumberGenerator> g_rng();
 // for each problem in this case the method GlobalState::get_id would also have to be
 // changed.
 extern StateRegistry *g_state_registry;
-extern PerStateInformation<std::vector<ap_float>> g_cost_information;
+// If true, state registries detect duplicates with the open-addressing
+// StateHashTable instead of std::unordered_set (see --state-hash-table).
+extern bool g_use_open_addressing;
 extern utils::PlanVisLogger *g_plan_logger;
 extern int g_last_arithmetic_axiom_layer;
 extern int g_comparison_axiom_layer;
@@ -7,9 +7,12 @@
 #include "option_parser.h"
 #include "operator_cost.h"
 #include "plugin.h"
+#include "projection_cache.h"
 
 #include "tasks/cost_adapted_task.h"
 #include "numeric_operator_counting/numeric_helper.h"
+#include "utils/memory.h"
+#include "utils/system.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -20,7 +23,9 @@ using namespace std;
 Heuristic::Heuristic(const Options &opts)
     : description(opts.get_unparsed_config()),
       initialized(false),
+      is_preferred_operator(g_operators.size(), false),
       multiplicator(0),
+      projection_cache_memory(opts.get<int>("projection_cache_memory")),
       heuristic_cache(HEntry(NO_VALUE_INT, true)), //TODO: is true really a good idea here?
       cache_h_values(opts.get<bool>("cache_estimates")),
       task(get_task_from_options(opts)),
@@ -35,13 +40,49 @@ Heuristic::Heuristic(const Options &opts)
 Heuristic::~Heuristic() {
 }
 
+void Heuristic::initialize_if_needed() {
+    if (initialized)
+        return;
+    initialize();
+    initialized = true;
+
+    if (projection_cache_memory > 0) {
+        vector<int> variables;
+        vector<int> numeric_variables;
+        if (!get_relevant_variables(variables, numeric_variables)) {
+            cerr << "The heuristic " << description
+                 << " does not support the projection cache." << endl;
+            utils::exit_with(utils::ExitCode::UNSUPPORTED);
+        }
+        projection_cache = utils::make_unique_ptr<ProjectionCache>(
+            move(variables), move(numeric_variables),
+            static_cast<size_t>(projection_cache_memory) * 1024 * 1024);
+    }
+}
+
+bool Heuristic::get_relevant_variables(vector<int> &, vector<int> &) const {
+    return false;
+}
+
+void Heuristic::print_statistics() const {
+    if (projection_cache)
+        projection_cache->print_statistics();
+}
+
 void Heuristic::set_preferred(const GlobalOperator *op) {
-    if (!op->is_marked()) {
-        op->mark();
+    assert(op >= &g_operators[0] && op < &g_operators[0] + g_operators.size());
+    vector<bool>::reference is_preferred = is_preferred_operator[op - &g_operators[0]];
+    if (!is_preferred) {
+        is_preferred = true;
         preferred_operators.push_back(op);
     }
 }
 
+void Heuristic::unmark_preferred_operators() {
+    for (const GlobalOperator *preferred_operator : preferred_operators)
+        is_preferred_operator[preferred_operator - &g_operators[0]] = false;
+}
+
 void Heuristic::set_preferred(OperatorProxy op) {
     set_preferred(op.get_global_operator());
 }
@@ -89,6 +130,15 @@ void Heuristic::add_options_to_parser(OptionParser &parser) {
     parser.add_option<bool>("cache_estimates", "cache heuristic estimates", "true");
     parser.add_option<bool>("redundant_constraints","add redundant_constraints", "true");
     parser.add_option<bool>("rounding_up","rounding up the heuristic value", "false");
+    parser.add_option<int>(
+        "projection_cache_memory",
+        "maximum memory in MiB for caching heuristic values by the values of "
+        "the variables the heuristic depends on. States that only differ in "
+        "other variables share a cache entry, and the least recently used "
+        "entries are replaced if the cache is full. Only supported by "
+        "heuristics that know their relevant variables. 0 disables the cache.",
+        "0",
+        Bounds("0", "infinity"));
 }
 
 // This solution to get default values seems nonoptimal.
@@ -100,16 +150,14 @@ Options Heuristic::default_options() {
     opts.set<bool>("cache_estimates", false);
     opts.set<bool>("redundant_constraints", false);
     opts.set<bool>("rounding_up", false);
+    opts.set<int>("projection_cache_memory", 0);
     return opts;
 }
 
 EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     EvaluationResult result;
 
-    if (!initialized) {
-        initialize();
-        initialized = true;
-    }
+    initialize_if_needed();
 
     assert(preferred_operators.empty());
 
@@ -122,13 +170,20 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
         heuristic_cache[state].h != NO_VALUE && !heuristic_cache[state].dirty) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
+    } else if (!calculate_preferred && projection_cache &&
+               projection_cache->lookup(convert_global_state(state), heuristic)) {
+        if (cache_h_values) {
+            heuristic_cache[state] = HEntry(heuristic, false);
+        }
+        result.set_count_evaluation(false);
     } else {
         heuristic = compute_heuristic(state);
+        if (projection_cache)
+            projection_cache->insert(convert_global_state(state), heuristic);
         if (cache_h_values) {
             heuristic_cache[state] = HEntry(heuristic, false);
         }
-        for (const GlobalOperator *preferred_operator : preferred_operators)
-            preferred_operator->unmark();
+        unmark_preferred_operators();
         result.set_count_evaluation(true);
     }
 
@@ -12,6 +12,7 @@
 
 class GlobalOperator;
 class GlobalState;
+class ProjectionCache;
 class TaskProxy;
 
 namespace options {
@@ -41,7 +42,20 @@ class Heuristic : public ScalarEvaluator {
       this seems to be the only potential downside.
     */
     std::vector<const GlobalOperator *> preferred_operators;
+    /*
+      Marks the operators in preferred_operators (indexed like g_operators).
+      The marks belong to the heuristic instead of the (shared) operators,
+      so heuristics can be evaluated in several threads at once.
+    */
+    std::vector<bool> is_preferred_operator;
     int multiplicator;
+    void unmark_preferred_operators();
+
+    // Maximum memory of the projection cache (0 disables it).
+    const int projection_cache_memory;
+    std::unique_ptr<ProjectionCache> projection_cache;
+
+    void initialize_if_needed();
 protected:
     /*
       Cache for saving h values
@@ -64,6 +78,15 @@ protected:
     bool is_initialized() const {return initialized; }
     // TODO: Call with State directly once all heuristics support it.
     virtual ap_float compute_heuristic(const GlobalState &state) = 0;
+    /*
+      Heuristics whose values only depend on a subset of the variables
+      can override this method to store the relevant (regular and numeric)
+      variables and return true. This enables the projection cache, which
+      reuses the value of a state for all states with the same values of
+      these variables. The default implementation returns false.
+    */
+    virtual bool get_relevant_variables(std::vector<int> &variables,
+                                        std::vector<int> &numeric_variables) const;
     // Usage note: It's OK to set the same operator as preferred
     // multiple times -- it will still only appear in the list of
     // preferred operators for this heuristic once.
@@ -98,9 +121,8 @@ public:
 
     std::string get_description() const;
 
-    virtual void print_statistics() const {
-        // do nothing by default
-    }
+    // Heuristics that override this should call the base implementation.
+    virtual void print_statistics() const;
 
     bool is_h_dirty(GlobalState &state) {
         return heuristic_cache[state].dirty;
@@ -27,11 +27,11 @@ static IntPacker::Bin get_bit_mask(int from, int to) {
     }
 }
 
-static int get_bit_size_for_range(container_int range) {
+int IntPacker::get_bit_size_for_range(container_int range) {
 	if (range == numeric_limits<container_int>::max())
 		return BITS_PER_BIN; // HACK for doubles (10000000000 is never > 11111111111111) as a 65 bit 100000000000 is a 000000000000 on 64 bit representation
     int num_bits = 0;
-    while ((1ULL << num_bits) < static_cast<unsigned int>(range))
+    while ((1ULL << num_bits) < range)
         ++num_bits;
     return num_bits;
 }
@@ -68,6 +68,10 @@ public:
         return (buffer[bin_index] & read_mask) >> shift;
     }
 
+    int get_bin_index() const {
+        return bin_index;
+    }
+
     void set(Bin *buffer, container_int value) const {
 //        assert(value >= 0 && value < range);
 //    	if(value >= range) cout <<"Assertion fails, value = " << value << " while range = " << range << endl;
@@ -101,6 +105,10 @@ ap_float IntPacker::getDouble(const Bin *buffer, int var) const {
 }
 
 
+int IntPacker::get_bin_index(int var) const {
+    return var_infos[var].get_bin_index();
+}
+
 void IntPacker::set(Bin *buffer, int var, container_int value) const {
 //	if (DEBUG) cout << "set buffer var " << var << " to value " << value << endl;
     assert((int) var_infos.size() > var);
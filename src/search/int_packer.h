@@ -46,9 +46,18 @@ public:
     void set(Bin *buffer, int var, container_int value) const;
     void setDouble(Bin *buffer, int var, ap_float value) const;
 
+    // Index of the bin that contains the given variable.
+    int get_bin_index(int var) const;
+
     int get_num_bins() const {return num_bins; }
     std::size_t get_bin_size_in_bytes() const {return sizeof(Bin); }
 
+    /*
+      Number of bits needed to store values in {0, ..., range - 1}. The
+      maximal range stands for raw doubles and takes a full bin.
+    */
+    static int get_bit_size_for_range(container_int range);
+
     container_int packDouble(ap_float plainDouble) const;
     ap_float unpackDouble(container_int packedDouble) const;
 
@@ -43,7 +43,7 @@ class LandmarkCountHeuristic : public Heuristic {
     void set_exploration_goals(const GlobalState &state);
 
     Exploration *get_exploration() {return exploration; }
-    void convert_lms(LandmarkSet &lms_set, const std::vector<bool> &lms_vec);
+    void convert_lms(LandmarkSet &lms_set, const BitsetView &lms_vec);
 protected:
     virtual ap_float compute_heuristic(const GlobalState &state);
 public:
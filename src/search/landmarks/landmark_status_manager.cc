@@ -4,7 +4,8 @@ using namespace std;
 
 namespace landmarks {
 LandmarkStatusManager::LandmarkStatusManager(LandmarkGraph &graph)
-    : lm_graph(graph) {
+    : reached_lms(vector<bool>(graph.number_of_landmarks(), true)),
+      lm_graph(graph) {
     do_intersection = true;
 }
 
@@ -13,7 +14,7 @@ LandmarkStatusManager::~LandmarkStatusManager() {
 }
 
 
-vector<bool> &LandmarkStatusManager::get_reached_landmarks(const GlobalState &state) {
+BitsetView LandmarkStatusManager::get_reached_landmarks(const GlobalState &state) {
     return reached_lms[state];
 }
 
@@ -21,8 +22,8 @@ vector<bool> &LandmarkStatusManager::get_reached_landmarks(const GlobalState &st
 void LandmarkStatusManager::set_landmarks_for_initial_state() {
     // TODO use correct state registry here.
     const GlobalState &initial_state = g_initial_state();
-    vector<bool> &reached = get_reached_landmarks(initial_state);
-    reached.resize(lm_graph.number_of_landmarks());
+    BitsetView reached = get_reached_landmarks(initial_state);
+    reached.reset();
     //cout << "NUMBER OF LANDMARKS: " << lm_graph.number_of_landmarks() << endl;
 
     int inserted = 0;
@@ -47,13 +48,13 @@ void LandmarkStatusManager::set_landmarks_for_initial_state() {
                 }
             }
             if (lm_true) {
-                reached[node_p->get_id()] = true;
+                reached.set(node_p->get_id());
                 ++inserted;
             }
         } else {
             for (size_t i = 0; i < node_p->vals.size(); ++i) {
                 if ((int) initial_state[node_p->vars[i]] == node_p->vals[i]) {
-                    reached[node_p->get_id()] = true;
+                    reached.set(node_p->get_id());
                     ++inserted;
                     break;
                 }
@@ -67,51 +68,48 @@ void LandmarkStatusManager::set_landmarks_for_initial_state() {
 
 bool LandmarkStatusManager::update_reached_lms(
     const GlobalState &parent_state, const GlobalOperator &, const GlobalState &state) {
-    vector<bool> &parent_reached = get_reached_landmarks(parent_state);
-    vector<bool> &reached = get_reached_landmarks(state);
+    BitsetView parent_reached = get_reached_landmarks(parent_state);
+    BitsetView reached = get_reached_landmarks(state);
 
 
-    if (&parent_reached == &reached) {
+    if (parent_reached.get_blocks() == reached.get_blocks()) {
         assert(state.get_id() == parent_state.get_id());
         // This can happen, e.g., in Satellite-01.
         return false;
     }
 
-    bool intersect = (do_intersection && !reached.empty());
-    vector<bool> old_reached;
-    if (intersect) {
-        // Save old reached landmarks for this state.
-        // Swapping is faster than old_reached = reached, and we assign
-        // a new value to reached next anyway.
-        old_reached.swap(reached);
-    }
-
-    reached = parent_reached;
-
-
-
     int num_landmarks = lm_graph.number_of_landmarks();
-    assert(static_cast<int>(reached.size()) == num_landmarks);
-    assert(static_cast<int>(parent_reached.size()) == num_landmarks);
-    assert(!intersect || static_cast<int>(old_reached.size()) == num_landmarks);
-
-    for (int id = 0; id < num_landmarks; ++id) {
-        if (intersect && !old_reached[id]) {
-            reached[id] = false;
-        } else if (!reached[id]) {
-            LandmarkNode *node = lm_graph.get_lm_for_index(id);
-            if (node->is_true_in_state(state)) {
-                // cout << "New LM reached: id " << id << " ";
-                // lm_graph.dump_node(node);
-                if (landmark_is_leaf(*node, reached)) {
-                    //      cout << "inserting new LM into reached. (2)" << endl;
-                    reached[id] = true;
-                }
-                /*
-                   else {
-                   cout << "non-leaf, not inserting." << std::endl;
-                   }
-                 */
+    assert(reached.size() == num_landmarks);
+    assert(parent_reached.size() == num_landmarks);
+
+    // Save old reached landmarks for this state.
+    int num_blocks = reached.get_num_blocks();
+    const BitsetView::Block *blocks = reached.get_blocks();
+    old_reached.assign(blocks, blocks + num_blocks);
+
+    reached.copy_from(parent_reached);
+
+    const BitsetView::Block *parent_blocks = parent_reached.get_blocks();
+    for (int block = 0; block < num_blocks; ++block) {
+        BitsetView::Block old_block = do_intersection ? old_reached[block] : ~BitsetView::Block(0);
+        /*
+          Only landmarks that were not reached on another path before or are
+          not reached by the parent need to be considered. They are handled
+          in the order of their IDs, because landmark_is_leaf depends on the
+          landmarks handled before.
+        */
+        BitsetView::Block candidates = ~(parent_blocks[block] & old_block) &
+            BitsetView::get_valid_mask(num_landmarks, block);
+        while (candidates) {
+            int bit = __builtin_ctzll(candidates);
+            candidates &= candidates - 1;
+            int id = block * BitsetView::BITS_PER_BLOCK + bit;
+            if (!((old_block >> bit) & 1)) {
+                reached.reset(id);
+            } else {
+                LandmarkNode *node = lm_graph.get_lm_for_index(id);
+                if (node->is_true_in_state(state) && landmark_is_leaf(*node, reached))
+                    reached.set(id);
             }
         }
     }
@@ -121,7 +119,7 @@ bool LandmarkStatusManager::update_reached_lms(
 }
 
 bool LandmarkStatusManager::update_lm_status(const GlobalState &state) {
-    vector<bool> &reached = get_reached_landmarks(state);
+    BitsetView reached = get_reached_landmarks(state);
 
     const set<LandmarkNode *> &nodes = lm_graph.get_nodes();
     // initialize all nodes to not reached and not effect of unused ALM
@@ -129,7 +127,7 @@ bool LandmarkStatusManager::update_lm_status(const GlobalState &state) {
     for (lit = nodes.begin(); lit != nodes.end(); ++lit) {
         LandmarkNode &node = **lit;
         node.status = lm_not_reached;
-        if (reached[node.get_id()]) {
+        if (reached.test(node.get_id())) {
             node.status = lm_reached;
         }
     }
@@ -186,12 +184,12 @@ bool LandmarkStatusManager::check_lost_landmark_children_needed_again(const Land
 }
 
 bool LandmarkStatusManager::landmark_is_leaf(const LandmarkNode &node,
-                                             const vector<bool> &reached) const {
+                                             const BitsetView &reached) const {
 //Note: this is the same as !check_node_orders_disobeyed
     for (const auto &parent : node.parents) {
         LandmarkNode *parent_node = parent.first;
         if (true) // Note: no condition on edge type here
-            if (!reached[parent_node->get_id()]) {
+            if (!reached.test(parent_node->get_id())) {
                 //cout << "parent is not in reached: ";
                 //cout << parent_p << " ";
                 //lm_graph.dump_node(parent_p);
@@ -3,23 +3,32 @@
 
 #include "landmark_graph.h"
 
-#include "../per_state_information.h"
+#include "../per_state_bitset.h"
+
+#include <vector>
 
 namespace landmarks {
 class LandmarkStatusManager {
 private:
-    PerStateInformation<std::vector<bool>> reached_lms;
+    /*
+      Bitsets of states that were not reached yet have all bits set, so
+      that intersecting them with the landmarks reached on a new path has
+      no effect.
+    */
+    PerStateBitset reached_lms;
+    // Used in update_reached_lms to avoid reallocation.
+    std::vector<BitsetView::Block> old_reached;
 
     bool do_intersection;
     LandmarkGraph &lm_graph;
 
-    bool landmark_is_leaf(const LandmarkNode &node, const std::vector<bool> &reached) const;
+    bool landmark_is_leaf(const LandmarkNode &node, const BitsetView &reached) const;
     bool check_lost_landmark_children_needed_again(const LandmarkNode &node) const;
 public:
     LandmarkStatusManager(LandmarkGraph &graph);
     virtual ~LandmarkStatusManager();
 
-    std::vector<bool> &get_reached_landmarks(const GlobalState &state);
+    BitsetView get_reached_landmarks(const GlobalState &state);
 
     bool update_lm_status(const GlobalState &state);
 
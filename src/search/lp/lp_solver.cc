@@ -4,6 +4,7 @@
 
 #include "../option_parser.h"
 
+#include "../utils/hash.h"
 #include "../utils/system.h"
 
 #ifdef USE_LP
@@ -126,9 +127,22 @@ LPSolver::LPSolver(LPSolverType s_t, LPConstraintType c_t)
       num_permanent_constraints(0),
       has_temporary_constraints_(false),
       solver_type(s_t),
+      basis_status_supported(true),
+      num_solves(0),
+      num_iterations(0),
+      num_bound_changes(0),
+      num_unchanged_bounds(0),
+      num_added_temporary_constraints(0),
+      num_kept_temporary_constraints(0),
+      num_restored_bases(0),
       lp_type(c_t)
     {
       lp_solver = create_lp_solver(solver_type);
+      try {
+          lp_solver->setHintParam(OsiDoDualInResolve, true, OsiHintDo);
+      } catch (CoinError &error) {
+          handle_coin_error(error);
+      }
 }
     
 LPSolver::LPSolver(LPSolverType s_t)
@@ -137,8 +151,21 @@ LPSolver::LPSolver(LPSolverType s_t)
     num_permanent_constraints(0),
     has_temporary_constraints_(false),
     solver_type(s_t),
+    basis_status_supported(true),
+    num_solves(0),
+    num_iterations(0),
+    num_bound_changes(0),
+    num_unchanged_bounds(0),
+    num_added_temporary_constraints(0),
+    num_kept_temporary_constraints(0),
+    num_restored_bases(0),
     lp_type(LPConstraintType::LP) {
         lp_solver = create_lp_solver(solver_type);
+        try {
+            lp_solver->setHintParam(OsiDoDualInResolve, true, OsiHintDo);
+        } catch (CoinError &error) {
+            handle_coin_error(error);
+        }
     }
 
 void LPSolver::clear_temporary_data() {
@@ -159,6 +186,9 @@ void LPSolver::load_problem(LPObjectiveSense sense,
     clear_temporary_data();
     is_initialized = false;
     num_permanent_constraints = constraints.size();
+    temporary_constraints.clear();
+    temporary_constraint_hashes.clear();
+    temporary_constraint_used.clear();
 
     for (const LPVariable &var : variables) {
         col_lb.push_back(var.lower_bound);
@@ -246,50 +276,196 @@ void LPSolver::load_problem(LPObjectiveSense sense,
         handle_coin_error(error);
     }
 
+    current_row_lb = row_lb;
+    current_row_ub = row_ub;
+    current_col_lb = col_lb;
+    current_col_ub = col_ub;
     clear_temporary_data();
 }
 
-void LPSolver::add_temporary_constraints(const std::vector<LPConstraint> &constraints) {
-    if (!constraints.empty()) {
-        clear_temporary_data();
-        int num_rows = constraints.size();
-        for (const LPConstraint &constraint : constraints) {
-            row_lb.push_back(constraint.get_lower_bound());
-            row_ub.push_back(constraint.get_upper_bound());
-            rows.push_back(new CoinShallowPackedVector(
-                               constraint.get_variables().size(),
-                               constraint.get_variables().data(),
-                               constraint.get_coefficients().data(),
-                               false));
+void LPSolver::add_rows(const std::vector<LPConstraint> &constraints) {
+    clear_temporary_data();
+    int num_rows = constraints.size();
+    for (const LPConstraint &constraint : constraints) {
+        row_lb.push_back(constraint.get_lower_bound());
+        row_ub.push_back(constraint.get_upper_bound());
+        rows.push_back(new CoinShallowPackedVector(
+                           constraint.get_variables().size(),
+                           constraint.get_variables().data(),
+                           constraint.get_coefficients().data(),
+                           false));
+    }
+
+    try {
+        lp_solver->addRows(num_rows,
+                           rows.data(), row_lb.data(), row_ub.data());
+    } catch (CoinError &error) {
+        handle_coin_error(error);
+    }
+    current_row_lb.insert(current_row_lb.end(), row_lb.begin(), row_lb.end());
+    current_row_ub.insert(current_row_ub.end(), row_ub.begin(), row_ub.end());
+    for (CoinPackedVectorBase *row : rows) {
+        delete row;
+    }
+    clear_temporary_data();
+    is_solved = false;
+}
+
+void LPSolver::delete_rows(const std::vector<int> &indices) {
+    assert(is_sorted(indices.begin(), indices.end()));
+    if (indices.empty())
+        return;
+    try {
+        lp_solver->deleteRows(indices.size(), indices.data());
+    } catch (CoinError &error) {
+        handle_coin_error(error);
+    }
+    size_t num_kept = 0;
+    size_t next_deleted = 0;
+    for (size_t row = 0; row < current_row_lb.size(); ++row) {
+        if (next_deleted < indices.size() &&
+            indices[next_deleted] == static_cast<int>(row)) {
+            ++next_deleted;
+        } else {
+            current_row_lb[num_kept] = current_row_lb[row];
+            current_row_ub[num_kept] = current_row_ub[row];
+            ++num_kept;
         }
+    }
+    current_row_lb.resize(num_kept);
+    current_row_ub.resize(num_kept);
+    is_solved = false;
+}
 
-        try {
-            lp_solver->addRows(num_rows,
-                               rows.data(), row_lb.data(), row_ub.data());
-        } catch (CoinError &error) {
-            handle_coin_error(error);
+void LPSolver::add_variables(const std::vector<LPVariable> &variables) {
+    assert(!has_temporary_constraints_);
+    remove_unused_temporary_constraints();
+    if (variables.empty())
+        return;
+    clear_temporary_data();
+    int first_column = get_num_variables();
+    for (const LPVariable &var : variables) {
+        col_lb.push_back(var.lower_bound);
+        col_ub.push_back(var.upper_bound);
+        objective.push_back(var.objective_coefficient);
+    }
+    // The new variables do not occur in the loaded constraints.
+    CoinPackedVector empty_column;
+    vector<const CoinPackedVectorBase *> columns(variables.size(), &empty_column);
+    try {
+        lp_solver->addCols(variables.size(), columns.data(),
+                           col_lb.data(), col_ub.data(), objective.data());
+        if (lp_type == LPConstraintType::IP) {
+            for (size_t i = 0; i < variables.size(); ++i) {
+                if (variables[i].type == integer || variables[i].type == binary)
+                    lp_solver->setInteger(first_column + i);
+            }
+        }
+    } catch (CoinError &error) {
+        handle_coin_error(error);
+    }
+    current_col_lb.insert(current_col_lb.end(), col_lb.begin(), col_lb.end());
+    current_col_ub.insert(current_col_ub.end(), col_ub.begin(), col_ub.end());
+    clear_temporary_data();
+    is_solved = false;
+}
+
+void LPSolver::add_permanent_constraints(const std::vector<LPConstraint> &constraints) {
+    assert(!has_temporary_constraints_);
+    remove_unused_temporary_constraints();
+    if (!constraints.empty()) {
+        add_rows(constraints);
+        num_permanent_constraints += constraints.size();
+    }
+}
+
+void LPSolver::delete_permanent_constraints(const std::vector<int> &indices) {
+    assert(!has_temporary_constraints_);
+    remove_unused_temporary_constraints();
+    if (indices.empty())
+        return;
+    assert(indices.front() >= 0 && indices.back() < num_permanent_constraints);
+    delete_rows(indices);
+    num_permanent_constraints -= indices.size();
+}
+
+static size_t hash_constraint(const LPConstraint &constraint) {
+    size_t hash = 0;
+    for (int var : constraint.get_variables())
+        utils::hash_combine(hash, var);
+    for (double coefficient : constraint.get_coefficients())
+        utils::hash_combine(hash, coefficient);
+    return hash;
+}
+
+void LPSolver::add_temporary_constraints(const std::vector<LPConstraint> &constraints) {
+    if (constraints.empty())
+        return;
+    new_temporary_constraints.clear();
+    for (const LPConstraint &constraint : constraints) {
+        size_t hash = hash_constraint(constraint);
+        int kept_row = -1;
+        for (size_t i = 0; i < temporary_constraints.size(); ++i) {
+            if (!temporary_constraint_used[i] &&
+                temporary_constraint_hashes[i] == hash &&
+                temporary_constraints[i].get_variables() == constraint.get_variables() &&
+                temporary_constraints[i].get_coefficients() == constraint.get_coefficients()) {
+                kept_row = i;
+                break;
+            }
         }
-        for (CoinPackedVectorBase *row : rows) {
-            delete row;
+        if (kept_row == -1) {
+            new_temporary_constraints.push_back(constraint);
+        } else {
+            temporary_constraint_used[kept_row] = true;
+            set_constraint_bounds(num_permanent_constraints + kept_row,
+                                  constraint.get_lower_bound(),
+                                  constraint.get_upper_bound());
+            ++num_kept_temporary_constraints;
         }
-        clear_temporary_data();
-        has_temporary_constraints_ = true;
-        is_solved = false;
     }
+    if (!new_temporary_constraints.empty()) {
+        add_rows(new_temporary_constraints);
+        for (const LPConstraint &constraint : new_temporary_constraints) {
+            temporary_constraints.push_back(constraint);
+            temporary_constraint_hashes.push_back(hash_constraint(constraint));
+            temporary_constraint_used.push_back(true);
+        }
+        num_added_temporary_constraints += new_temporary_constraints.size();
+    }
+    has_temporary_constraints_ = true;
 }
 
 void LPSolver::clear_temporary_constraints() {
     if (has_temporary_constraints_) {
-        try {
-            lp_solver->restoreBaseModel(num_permanent_constraints);
-        } catch (CoinError &error) {
-            handle_coin_error(error);
-        }
+        fill(temporary_constraint_used.begin(), temporary_constraint_used.end(), false);
         has_temporary_constraints_ = false;
         is_solved = false;
     }
 }
 
+void LPSolver::remove_unused_temporary_constraints() {
+    unused_rows.clear();
+    size_t num_kept = 0;
+    for (size_t i = 0; i < temporary_constraints.size(); ++i) {
+        if (temporary_constraint_used[i]) {
+            if (num_kept != i) {
+                swap(temporary_constraints[num_kept], temporary_constraints[i]);
+                temporary_constraint_hashes[num_kept] = temporary_constraint_hashes[i];
+                temporary_constraint_used[num_kept] = true;
+            }
+            ++num_kept;
+        } else {
+            unused_rows.push_back(num_permanent_constraints + i);
+        }
+    }
+    temporary_constraints.erase(temporary_constraints.begin() + num_kept,
+                                temporary_constraints.end());
+    temporary_constraint_hashes.resize(num_kept);
+    temporary_constraint_used.resize(num_kept);
+    delete_rows(unused_rows);
+}
+
 double LPSolver::get_infinity() const {
     try {
         return lp_solver->getInfinity();
@@ -324,6 +500,12 @@ void LPSolver::set_objective_coefficient(int index, double coefficient) {
 
 void LPSolver::set_constraint_lower_bound(int index, double bound) {
     assert(index < get_num_constraints());
+    if (current_row_lb[index] == bound) {
+        ++num_unchanged_bounds;
+        return;
+    }
+    current_row_lb[index] = bound;
+    ++num_bound_changes;
     try {
         lp_solver->setRowLower(index, bound);
     } catch (CoinError &error) {
@@ -334,6 +516,12 @@ void LPSolver::set_constraint_lower_bound(int index, double bound) {
 
 void LPSolver::set_constraint_upper_bound(int index, double bound) {
     assert(index < get_num_constraints());
+    if (current_row_ub[index] == bound) {
+        ++num_unchanged_bounds;
+        return;
+    }
+    current_row_ub[index] = bound;
+    ++num_bound_changes;
     try {
         lp_solver->setRowUpper(index, bound);
     } catch (CoinError &error) {
@@ -342,8 +530,31 @@ void LPSolver::set_constraint_upper_bound(int index, double bound) {
     is_solved = false;
 }
 
+void LPSolver::set_constraint_bounds(int index, double lower_bound, double upper_bound) {
+    assert(index < get_num_constraints());
+    if (current_row_lb[index] == lower_bound && current_row_ub[index] == upper_bound) {
+        ++num_unchanged_bounds;
+        return;
+    }
+    current_row_lb[index] = lower_bound;
+    current_row_ub[index] = upper_bound;
+    ++num_bound_changes;
+    try {
+        lp_solver->setRowBounds(index, lower_bound, upper_bound);
+    } catch (CoinError &error) {
+        handle_coin_error(error);
+    }
+    is_solved = false;
+}
+
 void LPSolver::set_variable_lower_bound(int index, double bound) {
     assert(index < get_num_variables());
+    if (current_col_lb[index] == bound) {
+        ++num_unchanged_bounds;
+        return;
+    }
+    current_col_lb[index] = bound;
+    ++num_bound_changes;
     try {
         lp_solver->setColLower(index, bound);
     } catch (CoinError &error) {
@@ -354,6 +565,12 @@ void LPSolver::set_variable_lower_bound(int index, double bound) {
 
 void LPSolver::set_variable_upper_bound(int index, double bound) {
     assert(index < get_num_variables());
+    if (current_col_ub[index] == bound) {
+        ++num_unchanged_bounds;
+        return;
+    }
+    current_col_ub[index] = bound;
+    ++num_bound_changes;
     try {
         lp_solver->setColUpper(index, bound);
     } catch (CoinError &error) {
@@ -362,7 +579,80 @@ void LPSolver::set_variable_upper_bound(int index, double bound) {
     is_solved = false;
 }
 
+void LPSolver::get_basis(LPBasis &basis) const {
+    assert(has_optimal_solution());
+    assert(get_num_constraints() == num_permanent_constraints +
+           static_cast<int>(temporary_constraints.size()));
+    basis.packed_status.clear();
+    basis.temporary_constraint_hashes.clear();
+    basis.temporary_constraint_status.clear();
+    if (!basis_status_supported)
+        return;
+    int num_variables = get_num_variables();
+    column_status.resize(num_variables);
+    row_status.resize(get_num_constraints());
+    try {
+        lp_solver->getBasisStatus(column_status.data(), row_status.data());
+    } catch (CoinError &) {
+        // Not all OSI interfaces implement the basis status methods.
+        basis_status_supported = false;
+        return;
+    }
+    basis.num_variables = num_variables;
+    basis.num_permanent_constraints = num_permanent_constraints;
+    int num_statuses = num_variables + num_permanent_constraints;
+    basis.packed_status.assign((num_statuses + 3) / 4, 0);
+    for (int i = 0; i < num_statuses; ++i) {
+        int status = i < num_variables ? column_status[i] : row_status[i - num_variables];
+        assert(status >= 0 && status < 4);
+        basis.packed_status[i / 4] |= status << (2 * (i % 4));
+    }
+    for (size_t i = 0; i < temporary_constraints.size(); ++i) {
+        basis.temporary_constraint_hashes.push_back(temporary_constraint_hashes[i]);
+        basis.temporary_constraint_status.push_back(
+            row_status[num_permanent_constraints + i]);
+    }
+}
+
+void LPSolver::set_basis(const LPBasis &basis) {
+    remove_unused_temporary_constraints();
+    int num_variables = get_num_variables();
+    if (!basis_status_supported || !is_initialized || basis.packed_status.empty() ||
+        basis.num_variables != num_variables ||
+        basis.num_permanent_constraints != num_permanent_constraints)
+        return;
+    column_status.resize(num_variables);
+    row_status.resize(get_num_constraints());
+    int num_statuses = num_variables + num_permanent_constraints;
+    for (int i = 0; i < num_statuses; ++i) {
+        int status = (basis.packed_status[i / 4] >> (2 * (i % 4))) & 3;
+        if (i < num_variables)
+            column_status[i] = status;
+        else
+            row_status[i - num_variables] = status;
+    }
+    // Status encoding of OSI: 0 free, 1 basic, 2 at upper, 3 at lower bound.
+    const int basic = 1;
+    for (size_t i = 0; i < temporary_constraints.size(); ++i) {
+        int status = basic;
+        for (size_t j = 0; j < basis.temporary_constraint_hashes.size(); ++j) {
+            if (basis.temporary_constraint_hashes[j] == temporary_constraint_hashes[i]) {
+                status = basis.temporary_constraint_status[j];
+                break;
+            }
+        }
+        row_status[num_permanent_constraints + i] = status;
+    }
+    try {
+        if (lp_solver->setBasisStatus(column_status.data(), row_status.data()) == 0)
+            ++num_restored_bases;
+    } catch (CoinError &) {
+        basis_status_supported = false;
+    }
+}
+
 void LPSolver::solve() {
+    remove_unused_temporary_constraints();
     try {
 //        stringstream s;
 //        s << "model";
@@ -389,6 +679,8 @@ void LPSolver::solve() {
             utils::exit_with(ExitCode::CRITICAL_ERROR);
         }
         is_solved = true;
+        ++num_solves;
+        num_iterations += lp_solver->getIterationCount();
 
     } catch (CoinError &error) {
         handle_coin_error(error);
@@ -450,6 +742,17 @@ int LPSolver::has_temporary_constraints() const {
 void LPSolver::print_statistics() const {
     cout << "LP variables: " << get_num_variables() << endl;
     cout << "LP constraints: " << get_num_constraints() << endl;
+    cout << "LP solves: " << num_solves << endl;
+    cout << "LP simplex iterations: " << num_iterations << endl;
+    if (num_solves > 0) {
+        cout << "LP simplex iterations per solve: "
+             << static_cast<double>(num_iterations) / num_solves << endl;
+    }
+    cout << "LP bound changes: " << num_bound_changes
+         << " (" << num_unchanged_bounds << " unchanged bounds skipped)" << endl;
+    cout << "LP temporary constraints: " << num_added_temporary_constraints
+         << " added, " << num_kept_temporary_constraints << " kept" << endl;
+    cout << "LP restored bases: " << num_restored_bases << endl;
 }
 
     void LPSolver::set_time_limit(double time) const{
@@ -97,6 +97,25 @@ struct LPVariable {
     ~LPVariable();
 };
 
+/*
+  Basis of a solved LP: the status of all variables and permanent
+  constraints, and of the temporary constraints identified by their
+  coefficients. Restoring it for a similar LP (e.g. the LP of a successor
+  state) lets the solver start from there instead of the basis of whatever
+  LP it solved last.
+*/
+class LPBasis {
+    friend class LPSolver;
+    int num_variables;
+    int num_permanent_constraints;
+    // Two bits per status, four statuses per byte.
+    std::vector<unsigned char> packed_status;
+    std::vector<std::size_t> temporary_constraint_hashes;
+    std::vector<unsigned char> temporary_constraint_status;
+public:
+    LPBasis() : num_variables(0), num_permanent_constraints(0) {}
+};
+
 #ifdef __GNUG__
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -124,7 +143,48 @@ class LPSolver {
     std::vector<double> row_lb;
     std::vector<double> row_ub;
     std::vector<CoinPackedVectorBase *> rows;
+    mutable std::vector<int> column_status;
+    mutable std::vector<int> row_status;
     void clear_temporary_data();
+    void add_rows(const std::vector<LPConstraint> &constraints);
+    // Indices must be sorted and unique.
+    void delete_rows(const std::vector<int> &indices);
+
+    /*
+      Temporary constraints stay loaded after clear_temporary_constraints()
+      until the next LP is solved. If they are added again, e.g. because a
+      successor state has the same landmark, the row and its basis status
+      are kept and only its bounds are updated. Rows that are not added again
+      are deleted before solving.
+    */
+    std::vector<LPConstraint> temporary_constraints;
+    std::vector<std::size_t> temporary_constraint_hashes;
+    std::vector<bool> temporary_constraint_used;
+    std::vector<LPConstraint> new_temporary_constraints;
+    std::vector<int> unused_rows;
+    void remove_unused_temporary_constraints();
+    mutable bool basis_status_supported;
+
+    /*
+      Bounds of all rows and columns as last passed to the solver. Setting
+      a bound to its current value does not touch the solver, so solve()
+      re-optimizes from the current basis (the last solution or a basis
+      restored with set_basis) with the dual simplex and only has to repair
+      the bounds that actually changed.
+    */
+    std::vector<double> current_row_lb;
+    std::vector<double> current_row_ub;
+    std::vector<double> current_col_lb;
+    std::vector<double> current_col_ub;
+
+    // for statistics only
+    int num_solves;
+    long long num_iterations;
+    long long num_bound_changes;
+    long long num_unchanged_bounds;
+    long long num_added_temporary_constraints;
+    long long num_kept_temporary_constraints;
+    int num_restored_bases;
 public:
     LPConstraintType lp_type;
     LP_METHOD(explicit LPSolver(LPSolverType solver_type, LPConstraintType lp_type))
@@ -141,6 +201,17 @@ public:
                   LPObjectiveSense sense,
                   const std::vector<LPVariable> &variables,
                   const std::vector<LPConstraint> &constraints))
+    /*
+      Extend the loaded problem without reloading it, so the solver keeps
+      its basis. Temporary constraints must be cleared before.
+    */
+    LP_METHOD(void add_variables(const std::vector<LPVariable> &variables))
+    LP_METHOD(void add_permanent_constraints(const std::vector<LPConstraint> &constraints))
+    /*
+      Delete the permanent constraints with the given indices, which must be
+      sorted and unique. Later constraints move down to close the gaps.
+    */
+    LP_METHOD(void delete_permanent_constraints(const std::vector<int> &indices))
     LP_METHOD(void add_temporary_constraints(const std::vector<LPConstraint> &constraints))
     LP_METHOD(void clear_temporary_constraints())
     LP_METHOD(double get_infinity() const)
@@ -149,9 +220,29 @@ public:
     LP_METHOD(void set_objective_coefficient(int index, double coefficient))
     LP_METHOD(void set_constraint_lower_bound(int index, double bound))
     LP_METHOD(void set_constraint_upper_bound(int index, double bound))
+    /*
+      Sets both bounds at once. Unlike two separate calls, this cannot
+      fail because the old upper bound is below the new lower bound or
+      vice versa.
+    */
+    LP_METHOD(void set_constraint_bounds(int index, double lower_bound, double upper_bound))
     LP_METHOD(void set_variable_lower_bound(int index, double bound))
     LP_METHOD(void set_variable_upper_bound(int index, double bound))
 
+    /*
+      Store the basis of the last solved LP, which must have an optimal
+      solution. Leaves the basis empty if the solver cannot report it.
+    */
+    LP_METHOD(void get_basis(LPBasis &basis) const)
+    /*
+      Start the next solve from the given basis. Call it after the temporary
+      constraints for the next LP have been added. Temporary constraints
+      that are not part of the basis start as basic. Does nothing if the
+      basis is empty or belongs to an LP with different variables or
+      permanent constraints.
+    */
+    LP_METHOD(void set_basis(const LPBasis &basis))
+
     LP_METHOD(void solve())
 
     /*
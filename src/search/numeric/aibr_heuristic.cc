@@ -36,6 +36,15 @@ ap_float AIBRHeuristic::compute_aibr_estimate() {
 		applicable_operators.clear();
 		for (auto unary_ops: applicable_operator_to_unary_operator) {
 			NumericState nextState = planning_graph.back().duplicate();
+			step_effects.clear();
+			for (auto op : unary_ops) {
+				if (op->is_numeric_operator())
+					step_effects.add(planning_graph.back().get_val(op->effect.aff_variable_index),
+									 op->effect.assign_type,
+									 planning_graph.back().get_val(op->effect.val_or_ass_var_index));
+			}
+			step_effects.compute();
+			size_t num_effects = 0;
 			auto it = unary_ops.begin();
 			bool change = false;
 			while (it != unary_ops.end()) {
@@ -44,9 +53,8 @@ ap_float AIBRHeuristic::compute_aibr_estimate() {
 				if (op->is_numeric_operator()) {
 					Interval oldval = planning_graph.back().get_val(op->effect.aff_variable_index);
 					ap_float aff_cost = planning_graph.back().get_cost(op->effect.aff_variable_index);
-					Interval ass_val =  planning_graph.back().get_val(op->effect.val_or_ass_var_index);
 					ap_float ass_cost = planning_graph.back().get_cost(op->effect.val_or_ass_var_index);
-					Interval newval = compute(oldval, op->effect.assign_type, ass_val);
+					Interval newval = step_effects.get_result(num_effects++);
 					ap_float cost = update_cost(aff_cost, ass_cost);
 					cost += op->base_cost;
 					cost = update_cost(cost, op->precondition_cost); 
@@ -63,15 +71,22 @@ ap_float AIBRHeuristic::compute_aibr_estimate() {
 				}
 			}
 			if (change) {
+				step_assignments.clear();
+				for (auto &ax : numeric_axioms) {
+					if (ax.is_assignment_axiom())
+						step_assignments.add(planning_graph.back().get_val(ax.axiom_left_var),
+											 ax.ass_ax_op,
+											 planning_graph.back().get_val(ax.axiom_right_var));
+				}
+				step_assignments.compute();
+				size_t num_assignments = 0;
 				for (size_t i = 0; i < numeric_axioms.size(); ++i) {
 					auto ax = &numeric_axioms[i];
 					if (ax->is_assignment_axiom()) {
-						Interval leftval = planning_graph.back().get_val(ax->axiom_left_var);
-						Interval rightval = planning_graph.back().get_val(ax->axiom_right_var);
 						ap_float leftcost = planning_graph.back().get_cost(ax->axiom_left_var);
 						ap_float rightcost = planning_graph.back().get_cost(ax->axiom_right_var);
 
-						Interval newval = compute(leftval, ax->ass_ax_op, rightval);
+						Interval newval = step_assignments.get_result(num_assignments++);
 						ap_float cost = max(leftcost, rightcost);
 						nextState.new_val_for(ax->effect.aff_variable_index, newval, ax, cost);
 					} else {
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "additive_interval_based_relaxation.h"
+#include "interval_batch.h"
 #include "interval_relaxation_heuristic.h"
 #include "../global_state.h"
 #include "../task_proxy.h"
@@ -15,6 +16,9 @@ namespace aibr_heuristic {
 
 class AIBRHeuristic : public additive_interval_based_relaxation::AdditiveIntervalBasedRelaxation {
   std::vector<std::list<UnaryOperator*>> applicable_operator_to_unary_operator;
+  // Effects of the numeric operators and assignment axioms of one step.
+  IntervalEffects step_effects;
+  IntervalAssignments step_assignments;
 protected:
   ap_float compute_aibr_estimate();
   virtual void initialize() override;
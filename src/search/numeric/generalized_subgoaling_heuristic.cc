@@ -55,7 +55,7 @@ namespace generalized_subgoaling_heuristic {
         State state = convert_global_state(global_state);
         OperatorsProxy ops = task_proxy.get_operators();
 
-        HeapQueue<int> q; // cannot use adaptive queue when costs are non integer
+        q.clear();
         open.assign(preconditions_to_id.size(), false);
         closed.assign(preconditions_to_id.size(), false);
         dist.assign(preconditions_to_id.size(), max_float);
@@ -204,7 +204,7 @@ namespace generalized_subgoaling_heuristic {
         return min_cost;
     }
 
-    void GeneralizedSubgoalingHeuristic::update_cost_if_necessary(int cond, HeapQueue<int> &q, double current_cost) {
+    void GeneralizedSubgoalingHeuristic::update_cost_if_necessary(int cond, RadixQueue<int> &q, double current_cost) {
         if (current_cost == lps[cond]->get_infinity())
             return;
         if (open[cond]) {
@@ -385,6 +385,12 @@ namespace generalized_subgoaling_heuristic {
     
     GeneralizedSubgoalingHeuristic::~GeneralizedSubgoalingHeuristic() {
     }
+
+    bool GeneralizedSubgoalingHeuristic::get_relevant_variables(
+        vector<int> &variables, vector<int> &numeric_variables) const {
+        compute_goal_relevant_variables(task_proxy, variables, numeric_variables);
+        return true;
+    }
     
     static Plugin<Heuristic> _plugin("hgen", _parse);
     
@@ -20,6 +20,7 @@ protected:
 	virtual void initialize();
 	virtual ap_float compute_heuristic(const GlobalState &global_state);
 	virtual ap_float update_cost(ap_float old_cost, ap_float new_cost) {return std::max(old_cost, new_cost);}
+    virtual bool get_relevant_variables(vector<int> &variables, vector<int> &numeric_variables) const override;
     
     void setup(const GlobalState &global_state);
 
@@ -33,6 +34,7 @@ protected:
     vector<bool> open;
     vector<bool> closed;
     vector<bool> active_actions;
+    RadixQueue<int> q; // cannot use adaptive queue when costs are non integer
 
     vector<set<int>> effect_of; // index: proposition, value, set actions that can achieved the proposition 
     vector<set<int>> possible_achievers; // index: action, value, set of numeric conditions that can be achieved by the action
@@ -44,7 +46,7 @@ protected:
     double max_float;
     void update_constraints(int preconditions_id, const State &state);
     double min_over_possible_achievers(int nc_id);
-    void update_cost_if_necessary(int cond, HeapQueue<int> &q, double current_cost);
+    void update_cost_if_necessary(int cond, RadixQueue<int> &q, double current_cost);
     void generate_possible_achievers();
     void generate_preconditions();
     void generate_linear_programs(lp::LPSolverType solver_type, lp::LPConstraintType constraint_type);
@@ -9,6 +9,35 @@
 
 using namespace std;
 
+/*
+  The compiler does not know that fesetround changes the result of floating
+  point operations and may move them across the call. Passing the operands
+  and the result through volatile variables ensures that the operation is
+  performed in the rounding mode that was set before.
+*/
+static inline ap_float rounded_sum(ap_float lhs, ap_float rhs) {
+	volatile ap_float operand = lhs;
+	volatile ap_float result = operand + rhs;
+	return result;
+}
+
+static inline ap_float rounded_difference(ap_float lhs, ap_float rhs) {
+	volatile ap_float operand = lhs;
+	volatile ap_float result = operand - rhs;
+	return result;
+}
+
+static inline ap_float rounded_product(ap_float lhs, ap_float rhs) {
+	volatile ap_float operand = lhs;
+	volatile ap_float result = operand * rhs;
+	return result;
+}
+
+static inline ap_float rounded_quotient(ap_float lhs, ap_float rhs) {
+	volatile ap_float operand = lhs;
+	volatile ap_float result = operand / rhs;
+	return result;
+}
 
 void Interval::dump() const {
 	cout << "[" << left << "; " << right << "]" <<endl;
@@ -93,9 +122,9 @@ Interval operator+ (const Interval &interval, const Interval &other) {
 	if (interval.defined() && other.defined()) {
 		const int originalRounding = fegetround( );
 		fesetround(FE_DOWNWARD);
-		ap_float lower = interval.left + other.left;
+		ap_float lower = rounded_sum(interval.left, other.left);
 		fesetround(FE_UPWARD);
-		ap_float upper = interval.right + other.right;
+		ap_float upper = rounded_sum(interval.right, other.right);
 		fesetround(originalRounding);
 		return Interval(lower, upper, interval.left_open || other.left_open, interval.right_open || other.right_open);
 	} else
@@ -107,9 +136,9 @@ Interval operator- (const Interval &interval, const Interval &other) {
 	if (interval.defined() && other.defined()) {
 		const int originalRounding = fegetround( );
 		fesetround(FE_DOWNWARD);
-		ap_float lower = interval.left - other.right;
+		ap_float lower = rounded_difference(interval.left, other.right);
 		fesetround(FE_UPWARD);
-		ap_float upper = interval.right - other.left;
+		ap_float upper = rounded_difference(interval.right, other.left);
 		fesetround(originalRounding);
 		return Interval(lower, upper, interval.left_open || other.left_open, interval.right_open || other.right_open);
 	} else
@@ -123,23 +152,23 @@ Interval operator* (const Interval &interval, const Interval &other) {
 
 		// determine lower bound and leftopen
 		fesetround(FE_DOWNWARD);
-		ap_float lower = interval.left * other.left;
+		ap_float lower = rounded_product(interval.left, other.left);
 		bool leftopen = interval.left_open || other.left_open;
-		ap_float better = interval.left * other.right;
+		ap_float better = rounded_product(interval.left, other.right);
 		if (better < lower) {
 			lower = better;
 			leftopen = interval.left_open || other.right_open;
 		}
 		if (better == lower && leftopen && !interval.left_open && !other.right_open)
 			leftopen = false;
-		better = interval.right * other.left;
+		better = rounded_product(interval.right, other.left);
 		if (better < lower) {
 			lower = better;
 			leftopen = interval.right_open || other.left_open;
 		}
 		if (better == lower && leftopen && !interval.right_open && !other.left_open)
 			leftopen = false;
-		better = interval.right * other.right;
+		better = rounded_product(interval.right, other.right);
 		if (better < lower) {
 			lower = better;
 			leftopen = interval.right_open || other.right_open;
@@ -149,23 +178,23 @@ Interval operator* (const Interval &interval, const Interval &other) {
 
 		// determine upper bound and rightopen
 		fesetround(FE_UPWARD);
-		ap_float upper = interval.left * other.left;
+		ap_float upper = rounded_product(interval.left, other.left);
 		bool rightopen = interval.left_open || other.left_open;
-		better = interval.left * other.right;
+		better = rounded_product(interval.left, other.right);
 		if (better > upper) {
 			upper = better;
 			rightopen = interval.left_open || other.right_open;
 		}
 		if (better == upper && rightopen && !interval.left_open && !other.right_open)
 			rightopen = false;
-		better = interval.right * other.left;
+		better = rounded_product(interval.right, other.left);
 		if (better > upper) {
 			upper = better;
 			rightopen = interval.right_open || other.left_open;
 		}
 		if (better == upper && rightopen && !interval.right_open && !other.left_open)
 			rightopen = false;
-		better = interval.right * other.right;
+		better = rounded_product(interval.right, other.right);
 		if (better > upper) {
 			upper = better;
 			rightopen = interval.right_open || other.right_open;
@@ -189,12 +218,12 @@ Interval operator/ (const Interval &interval, const Interval &other) {
 			const int originalRounding = fegetround( );
 			if (other.right != 0) {
 				fesetround(FE_DOWNWARD);
-				lower = 1/other.right;
+				lower = rounded_quotient(1, other.right);
 				leftopen = other.right_open;
 			}
 			if (other.left != 0) {
 				fesetround(FE_UPWARD);
-				upper = 1/other.left;
+				upper = rounded_quotient(1, other.left);
 				rightopen = other.left_open;
 			}
 			fesetround(originalRounding);
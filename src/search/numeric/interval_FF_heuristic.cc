@@ -53,7 +53,7 @@ ap_float IntervalFFHeuristic::compute_heuristic(
 
 	// setup plan extraction
 	plan = RelaxedPlan(task_proxy.get_operators().size(), planning_graph.size()); // reset plan
-	numeric_markings = vector<vector<bool> > (planning_graph.front().size(), vector<bool> (planning_graph.size(), false));
+	numeric_markings = vector<vector<bool> > (planning_graph.get_num_variables(), vector<bool> (planning_graph.size(), false));
 
 //	cout << "h_FF: marking operators..." << endl;
 	// mark operators
@@ -129,12 +129,12 @@ void IntervalFFHeuristic::mark_preferred_operators_and_relaxed_plan(
             	assert(goal->reached_in_layer >= 1);
             	int my_layer = goal->reached_in_layer;
             	assert((int) planning_graph.size() > my_layer);
-            	Interval left = planning_graph[my_layer].get_val(unary_op->axiom_left_var);
-            	Interval right = planning_graph[my_layer].get_val(unary_op->axiom_right_var);
-            	ap_float left_init = planning_graph[0].get_val(unary_op->axiom_left_var).left;
-            	assert (left_init == planning_graph[0].get_val(unary_op->axiom_left_var).right); // initial value has to be point interval
-            	ap_float right_init = planning_graph[0].get_val(unary_op->axiom_right_var).left;
-            	assert (right_init == planning_graph[0].get_val(unary_op->axiom_right_var).right); // initial value has to be point interval
+            	Interval left = planning_graph.get_val(my_layer, unary_op->axiom_left_var);
+            	Interval right = planning_graph.get_val(my_layer, unary_op->axiom_right_var);
+            	ap_float left_init = planning_graph.get_val(0, unary_op->axiom_left_var).left;
+            	assert (left_init == planning_graph.get_val(0, unary_op->axiom_left_var).right); // initial value has to be point interval
+            	ap_float right_init = planning_graph.get_val(0, unary_op->axiom_right_var).left;
+            	assert (right_init == planning_graph.get_val(0, unary_op->axiom_right_var).right); // initial value has to be point interval
             	Targetvalues targetvals = determine_target_values(left, left_init, unary_op->comp_ax_op, right, right_init);
             	assert(left.contains(targetvals.left));
             	mark_preferred_operators_and_relaxed_plan(state, unary_op->axiom_left_var, targetvals.left, goal->reached_in_layer);
@@ -152,12 +152,12 @@ void IntervalFFHeuristic::mark_preferred_operators_and_relaxed_plan(
 //	if(numeric_markings.size() <= num_var) cout << "Assertion about to fail. Numeric markings size = " << numeric_markings.size() << " variables, index = " << num_var << endl;
 	assert(numeric_markings.size() > num_var);
 	assert(numeric_markings[num_var].size() > layer);
-	if (!planning_graph[layer].get_val(num_var).contains(target_value)) {
+	if (!planning_graph.get_val(layer, num_var).contains(target_value)) {
 		cout << "Assertion will fail" << endl;
-		cout << precise_str(target_value) << " is not contained in the interval of var #" << num_var << " with value " << planning_graph[layer].get_val(num_var).precise_str() << " in layer " << layer << endl;
+		cout << precise_str(target_value) << " is not contained in the interval of var #" << num_var << " with value " << planning_graph.get_val(layer, num_var).precise_str() << " in layer " << layer << endl;
 		cout << "var " << num_var << " = " << g_numeric_var_names[num_var] << endl;
 	}
-	assert(planning_graph[layer].get_val(num_var).contains(target_value));
+	assert(planning_graph.get_val(layer, num_var).contains(target_value));
 	if(!numeric_markings[num_var][layer]) {
 		numeric_markings[num_var][layer] = true;
 		UnaryOperator* unary_op = determine_achiever(num_var, layer, target_value);
@@ -172,12 +172,12 @@ void IntervalFFHeuristic::mark_preferred_operators_and_relaxed_plan(
                 // This is not an axiom.
                 if (unary_op->effect.numeric) {
                   	// handle "implicit preconditions"
-                  	Interval left = planning_graph[layer-1].get_val(unary_op->effect.aff_variable_index);
-                  	ap_float left_init = planning_graph[0].get_val(unary_op->effect.aff_variable_index).left;
-                  	assert (left_init == planning_graph[0].get_val(unary_op->effect.aff_variable_index).right); // initial value has to be point interval
-                  	Interval right = planning_graph[layer-1].get_val(unary_op->effect.val_or_ass_var_index);
-                  	ap_float right_init = planning_graph[0].get_val(unary_op->effect.val_or_ass_var_index).left;
-                  	assert (right_init == planning_graph[0].get_val(unary_op->effect.val_or_ass_var_index).right); // initial value has to be point interval
+                  	Interval left = planning_graph.get_val(layer-1, unary_op->effect.aff_variable_index);
+                  	ap_float left_init = planning_graph.get_val(0, unary_op->effect.aff_variable_index).left;
+                  	assert (left_init == planning_graph.get_val(0, unary_op->effect.aff_variable_index).right); // initial value has to be point interval
+                  	Interval right = planning_graph.get_val(layer-1, unary_op->effect.val_or_ass_var_index);
+                  	ap_float right_init = planning_graph.get_val(0, unary_op->effect.val_or_ass_var_index).left;
+                  	assert (right_init == planning_graph.get_val(0, unary_op->effect.val_or_ass_var_index).right); // initial value has to be point interval
                   	assert((compute(left, unary_op->effect.assign_type, right) || left).contains(target_value));
                   	Targetvalues targetvals = determine_target_values(left, left_init, unary_op->effect.assign_type, right, right_init, target_value);
                   	assert(left.contains(targetvals.left));
@@ -197,26 +197,14 @@ void IntervalFFHeuristic::mark_preferred_operators_and_relaxed_plan(
                 }
             } else if (unary_op->is_numeric_axiom) {
             	assert(layer >= 1);
-            	assert(planning_graph.size() > layer);
-            	Interval left = planning_graph[layer].get_val(unary_op->axiom_left_var); // Axioms operate on same layer
-            	Interval right = planning_graph[layer].get_val(unary_op->axiom_right_var);
-//            	if (!apply_ass_axiom(left, unary_op->ass_ax_op, right).contains(target_value)) {
-//            		cout << "Was trying to enable " << target_value << " for " << g_numeric_var_names[num_var] << " with " << unary_op->str() << endl;
-//            		cout << "layer " << layer << " varno " << num_var << endl;
-//            		cout << "Assertion will fail: " << left << unary_op->ass_ax_op << right << " = " << apply_ass_axiom(left, unary_op->ass_ax_op, right) << " target = " << target_value << endl;
-//
-//            		for (size_t l = 0; l < planning_graph.size(); ++l) {
-//            			auto achs_in_layer = planning_graph[l].get_achievers(num_var);
-//            			cout << "Layer " << l << " val= " << planning_graph[l].get_val(num_var) << " cost= " << planning_graph[l].get_cost(num_var)
-//            							<< " #achievers = " << achs_in_layer.size()<< endl;
-//            			for (auto ac : achs_in_layer) cout << "     - " << ac->str() << endl;
-//            		}
-//            	}
+            	assert(planning_graph.size() > (int) layer);
+            	Interval left = planning_graph.get_val(layer, unary_op->axiom_left_var); // Axioms operate on same layer
+            	Interval right = planning_graph.get_val(layer, unary_op->axiom_right_var);
             	assert(compute(left, unary_op->ass_ax_op, right).contains(target_value));
-            	ap_float left_init = planning_graph[0].get_val(unary_op->axiom_left_var).left;
-            	assert (left_init == planning_graph[0].get_val(unary_op->axiom_left_var).right); // initial value has to be point interval
-            	ap_float right_init = planning_graph[0].get_val(unary_op->axiom_right_var).left;
-            	assert (right_init == planning_graph[0].get_val(unary_op->axiom_right_var).right); // initial value has to be point interval
+            	ap_float left_init = planning_graph.get_val(0, unary_op->axiom_left_var).left;
+            	assert (left_init == planning_graph.get_val(0, unary_op->axiom_left_var).right); // initial value has to be point interval
+            	ap_float right_init = planning_graph.get_val(0, unary_op->axiom_right_var).left;
+            	assert (right_init == planning_graph.get_val(0, unary_op->axiom_right_var).right); // initial value has to be point interval
             	Targetvalues targetvals = determine_target_values(left, left_init, unary_op->ass_ax_op, right, right_init, target_value);
             	assert(left.contains(targetvals.left));
             	mark_preferred_operators_and_relaxed_plan(state, unary_op->axiom_left_var, targetvals.left, layer);
@@ -230,48 +218,36 @@ void IntervalFFHeuristic::mark_preferred_operators_and_relaxed_plan(
 
 UnaryOperator* IntervalFFHeuristic::determine_achiever(int var_index,
 		size_t layer, ap_float target) {
-//	Interval current_value = planning_graph[layer].get_val(var_index);
-//	cout << "Have to determine achiever for target value " << target << " of " << var_index << " : "<< g_numeric_var_names[var_index] <<endl;
-//	cout << "    with current value " << current_value << " in layer " << layer
-//			<< " #a = " << planning_graph[layer].get_achievers(var_index).size() <<  endl;
-	assert(layer < planning_graph.size());
-	assert(planning_graph[layer].get_val(var_index).contains(target));
+	assert((int) layer < planning_graph.size());
+	assert(planning_graph.get_val(layer, var_index).contains(target));
 	if (layer == 0) {
-		assert(planning_graph[layer].get_val(var_index).contains(target));
+		assert(planning_graph.get_val(layer, var_index).contains(target));
 		return 0; // Initial value is already achieved, achiever is None
 	}
-	Interval before = planning_graph[layer-1].get_val(var_index);
+	Interval before = planning_graph.get_val(layer-1, var_index);
 //	cout << "iv before = " << before << endl;
 	if (before.contains(target)) {
 		return determine_achiever(var_index, layer-1, target); // follow "idle arc"
 	}
-	vector<UnaryOperator *> achievers = planning_graph[layer].get_achievers(var_index);
-//	if (achievers.size() == 0) {
-//		cout << "Assertion about to fail, dumping complete plangraph for variable " << var_index << " : " << g_numeric_var_names[var_index] << ":" << endl;
-//		for (size_t l = 0; l < planning_graph.size(); ++l) {
-//			auto achs_in_layer = planning_graph[l].get_achievers(var_index);
-//			cout << "Layer " << l << " val= " << planning_graph[l].get_val(var_index) << " cost= " << planning_graph[l].get_cost(var_index)
-//							<< " #achievers = " << achs_in_layer.size()<< endl;
-//			for (auto ac : achs_in_layer) cout << "     - " << ac->str() << endl;
-//		}
-//	}
-	assert(achievers.size() > 0);
+	auto achievers = planning_graph.get_achievers(layer, var_index);
+	assert(achievers.first != achievers.second);
 	UnaryOperator* best_achiever = 0;
 	ap_float cost = INF;
-	for (UnaryOperator* achiever: achievers) {
+	for (auto it = achievers.first; it != achievers.second; ++it) {
+		UnaryOperator* achiever = *it;
 		Interval first;
 		Interval second;
 		Interval result;
 		if (achiever->is_numeric_axiom) {
 			// assignment axiom -> axioms operate on the intervals in the same layer
-			first = planning_graph[layer].get_val(achiever->axiom_left_var);
-			second = planning_graph[layer].get_val(achiever->axiom_right_var);
+			first = planning_graph.get_val(layer, achiever->axiom_left_var);
+			second = planning_graph.get_val(layer, achiever->axiom_right_var);
 			result = compute(first, achiever->ass_ax_op, second);
 //			cout << first << " " << achiever->ass_ax_op << " " << second << " = " << result << endl;
 		} else {
 			// numeric operator -> operators use the intervals from the previous layer
-			first = planning_graph[layer-1].get_val(achiever->effect.aff_variable_index);
-			second = planning_graph[layer-1].get_val(achiever->effect.val_or_ass_var_index);
+			first = planning_graph.get_val(layer-1, achiever->effect.aff_variable_index);
+			second = planning_graph.get_val(layer-1, achiever->effect.val_or_ass_var_index);
 			result = compute(first, achiever->effect.assign_type, second);
 			result = result || first;
 //			cout << first << " " << achiever->effect.assign_type << " " << second << " = " << result << endl;
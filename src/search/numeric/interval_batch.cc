@@ -0,0 +1,267 @@
+#include "interval_batch.h"
+
+#include <cassert>
+#include <fenv.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INTERVAL_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+const unsigned char LEFT_OPEN = IntervalBatch::LEFT_OPEN;
+const unsigned char RIGHT_OPEN = IntervalBatch::RIGHT_OPEN;
+
+inline void set_undefined(IntervalBatch &result, size_t i) {
+	result.left[i] = INF;
+	result.right[i] = -INF;
+	result.open[i] = 0;
+}
+
+/*
+  Results of operations with an undefined operand are undefined, and so
+  are empty results (see the constructor of Interval).
+*/
+void normalize(const IntervalBatch &lhs, const IntervalBatch &rhs,
+			   IntervalBatch &result, size_t begin) {
+	for (size_t i = begin; i < result.size(); ++i) {
+		if (!(lhs.left[i] <= lhs.right[i]) || !(rhs.left[i] <= rhs.right[i]) ||
+			!(result.left[i] <= result.right[i]))
+			set_undefined(result, i);
+	}
+}
+
+#ifdef INTERVAL_BATCH_AVX2
+bool cpu_supports_avx2() {
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+}
+
+/*
+  Computes the sums (or differences) of the first intervals in groups of
+  four and returns the number of intervals handled. The caller handles
+  the rest. The result is normalized.
+*/
+template<bool DIFFERENCE>
+__attribute__((target("avx2")))
+size_t add_avx2(const IntervalBatch &lhs, const IntervalBatch &rhs,
+				IntervalBatch &result) {
+	const size_t size = lhs.size() - lhs.size() % 4;
+	const ap_float *lhs_left = lhs.left.data();
+	const ap_float *lhs_right = lhs.right.data();
+	// The lower bound of a difference uses the upper bound of rhs.
+	const ap_float *rhs_lower = DIFFERENCE ? rhs.right.data() : rhs.left.data();
+	const ap_float *rhs_upper = DIFFERENCE ? rhs.left.data() : rhs.right.data();
+	ap_float *result_left = result.left.data();
+	ap_float *result_right = result.right.data();
+
+	const int original_rounding = fegetround();
+	fesetround(FE_DOWNWARD);
+	for (size_t i = 0; i < size; i += 4) {
+		__m256d a = _mm256_loadu_pd(lhs_left + i);
+		__m256d b = _mm256_loadu_pd(rhs_lower + i);
+		_mm256_storeu_pd(result_left + i,
+						 DIFFERENCE ? _mm256_sub_pd(a, b) : _mm256_add_pd(a, b));
+	}
+	fesetround(FE_UPWARD);
+	for (size_t i = 0; i < size; i += 4) {
+		__m256d a = _mm256_loadu_pd(lhs_right + i);
+		__m256d b = _mm256_loadu_pd(rhs_upper + i);
+		_mm256_storeu_pd(result_right + i,
+						 DIFFERENCE ? _mm256_sub_pd(a, b) : _mm256_add_pd(a, b));
+	}
+	fesetround(original_rounding);
+
+	const __m256d undefined_left = _mm256_set1_pd(INF);
+	const __m256d undefined_right = _mm256_set1_pd(-INF);
+	for (size_t i = 0; i < size; i += 4) {
+		__m256d defined = _mm256_and_pd(
+			_mm256_cmp_pd(_mm256_loadu_pd(lhs_left + i), _mm256_loadu_pd(lhs_right + i), _CMP_LE_OQ),
+			_mm256_cmp_pd(_mm256_loadu_pd(rhs.left.data() + i), _mm256_loadu_pd(rhs.right.data() + i), _CMP_LE_OQ));
+		__m256d left = _mm256_loadu_pd(result_left + i);
+		__m256d right = _mm256_loadu_pd(result_right + i);
+		defined = _mm256_and_pd(defined, _mm256_cmp_pd(left, right, _CMP_LE_OQ));
+		_mm256_storeu_pd(result_left + i, _mm256_blendv_pd(undefined_left, left, defined));
+		_mm256_storeu_pd(result_right + i, _mm256_blendv_pd(undefined_right, right, defined));
+		int defined_mask = _mm256_movemask_pd(defined);
+		for (int j = 0; j < 4; ++j) {
+			result.open[i + j] = (defined_mask & (1 << j)) ?
+				(lhs.open[i + j] | rhs.open[i + j]) : 0;
+		}
+	}
+	return size;
+}
+#endif
+
+template<bool DIFFERENCE>
+void add(const IntervalBatch &lhs, const IntervalBatch &rhs, IntervalBatch &result) {
+	size_t begin = 0;
+#ifdef INTERVAL_BATCH_AVX2
+	if (cpu_supports_avx2())
+		begin = add_avx2<DIFFERENCE>(lhs, rhs, result);
+#endif
+	const size_t size = lhs.size();
+	const int original_rounding = fegetround();
+	fesetround(FE_DOWNWARD);
+	for (size_t i = begin; i < size; ++i) {
+		result.left[i] = DIFFERENCE ? lhs.left[i] - rhs.right[i]
+							 : lhs.left[i] + rhs.left[i];
+	}
+	fesetround(FE_UPWARD);
+	for (size_t i = begin; i < size; ++i) {
+		result.right[i] = DIFFERENCE ? lhs.right[i] - rhs.left[i]
+							  : lhs.right[i] + rhs.right[i];
+	}
+	fesetround(original_rounding);
+	for (size_t i = begin; i < size; ++i)
+		result.open[i] = lhs.open[i] | rhs.open[i];
+	normalize(lhs, rhs, result, begin);
+}
+
+/*
+  Minimum (LOWER) or maximum of the four products of the bounds and the
+  openness of the chosen bound, with the same tie-breaking as operator*.
+  The rounding mode is set by the caller.
+*/
+template<bool LOWER>
+inline ap_float multiply_bound(ap_float a_left, ap_float a_right, bool a_left_open, bool a_right_open,
+							   ap_float b_left, ap_float b_right, bool b_left_open, bool b_right_open,
+							   bool &bound_open) {
+	ap_float bound = a_left * b_left;
+	bound_open = a_left_open || b_left_open;
+	ap_float candidates[3] = {a_left * b_right, a_right * b_left, a_right * b_right};
+	bool first_open[3] = {a_left_open, a_right_open, a_right_open};
+	bool second_open[3] = {b_right_open, b_left_open, b_right_open};
+	for (int j = 0; j < 3; ++j) {
+		ap_float better = candidates[j];
+		if (LOWER ? better < bound : better > bound) {
+			bound = better;
+			bound_open = first_open[j] || second_open[j];
+		}
+		if (better == bound && bound_open && !first_open[j] && !second_open[j])
+			bound_open = false;
+	}
+	return bound;
+}
+
+void multiply(const IntervalBatch &lhs, const IntervalBatch &rhs, IntervalBatch &result) {
+	const size_t size = lhs.size();
+	const int original_rounding = fegetround();
+	fesetround(FE_DOWNWARD);
+	for (size_t i = 0; i < size; ++i) {
+		bool open;
+		result.left[i] = multiply_bound<true>(
+			lhs.left[i], lhs.right[i], lhs.open[i] & LEFT_OPEN, lhs.open[i] & RIGHT_OPEN,
+			rhs.left[i], rhs.right[i], rhs.open[i] & LEFT_OPEN, rhs.open[i] & RIGHT_OPEN, open);
+		result.open[i] = open ? LEFT_OPEN : 0;
+	}
+	fesetround(FE_UPWARD);
+	for (size_t i = 0; i < size; ++i) {
+		bool open;
+		result.right[i] = multiply_bound<false>(
+			lhs.left[i], lhs.right[i], lhs.open[i] & LEFT_OPEN, lhs.open[i] & RIGHT_OPEN,
+			rhs.left[i], rhs.right[i], rhs.open[i] & LEFT_OPEN, rhs.open[i] & RIGHT_OPEN, open);
+		if (open)
+			result.open[i] |= RIGHT_OPEN;
+	}
+	fesetround(original_rounding);
+	normalize(lhs, rhs, result, 0);
+}
+
+void divide(const IntervalBatch &lhs, const IntervalBatch &rhs, IntervalBatch &result,
+			IntervalBatch &inverse) {
+	const size_t size = lhs.size();
+	// Compute the inverses of rhs (if 0 is not contained in the interior).
+	inverse.resize(size);
+	const int original_rounding = fegetround();
+	fesetround(FE_DOWNWARD);
+	for (size_t i = 0; i < size; ++i) {
+		inverse.left[i] = -INF;
+		inverse.open[i] = 0;
+		if (rhs.right[i] != 0) {
+			inverse.left[i] = 1 / rhs.right[i];
+			if (rhs.open[i] & RIGHT_OPEN)
+				inverse.open[i] = LEFT_OPEN;
+		}
+	}
+	fesetround(FE_UPWARD);
+	for (size_t i = 0; i < size; ++i) {
+		inverse.right[i] = INF;
+		if (rhs.left[i] != 0) {
+			inverse.right[i] = 1 / rhs.left[i];
+			if (rhs.open[i] & LEFT_OPEN)
+				inverse.open[i] |= RIGHT_OPEN;
+		}
+	}
+	fesetround(original_rounding);
+	for (size_t i = 0; i < size; ++i) {
+		if (!(inverse.left[i] <= inverse.right[i]))
+			set_undefined(inverse, i);
+	}
+
+	multiply(lhs, inverse, result);
+
+	for (size_t i = 0; i < size; ++i) {
+		bool defined = lhs.left[i] <= lhs.right[i] && rhs.left[i] <= rhs.right[i];
+		if (!defined) {
+			set_undefined(result, i);
+		} else if (!(rhs.right[i] <= 0 || rhs.left[i] >= 0)) {
+			// 0 is contained in the interior of rhs.
+			result.left[i] = -INF;
+			result.right[i] = INF;
+			result.open[i] = 0;
+		}
+	}
+}
+}
+
+void compute_batch(const IntervalBatch &lhs, f_operator fop,
+				   const IntervalBatch &rhs, IntervalBatch &result,
+				   IntervalBatch &scratch) {
+	assert(lhs.size() == rhs.size());
+	result.resize(lhs.size());
+	switch (fop) {
+	case assign:
+		result.left = rhs.left;
+		result.right = rhs.right;
+		result.open = rhs.open;
+		break;
+	case scale_up:
+		multiply(lhs, rhs, result);
+		break;
+	case scale_down:
+		divide(lhs, rhs, result, scratch);
+		break;
+	case increase:
+		add<false>(lhs, rhs, result);
+		break;
+	case decrease:
+		add<true>(lhs, rhs, result);
+		break;
+	default: assert(false);
+	}
+}
+
+void compute_batch(const IntervalBatch &lhs, cal_operator calop,
+				   const IntervalBatch &rhs, IntervalBatch &result,
+				   IntervalBatch &scratch) {
+	assert(lhs.size() == rhs.size());
+	result.resize(lhs.size());
+	switch (calop) {
+	case sum:
+		add<false>(lhs, rhs, result);
+		break;
+	case diff:
+		add<true>(lhs, rhs, result);
+		break;
+	case mult:
+		multiply(lhs, rhs, result);
+		break;
+	case divi:
+		divide(lhs, rhs, result, scratch);
+		break;
+	default: assert(false);
+	}
+}
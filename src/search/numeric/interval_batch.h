@@ -0,0 +1,105 @@
+#ifndef NUMERIC_INTERVAL_BATCH_H
+#define NUMERIC_INTERVAL_BATCH_H
+
+#include "interval.h"
+
+#include <utility>
+#include <vector>
+
+/*
+  Intervals in packed form (structure of arrays). The open/closed flags of
+  the bounds are stored in a bitmask per interval.
+
+  The compute_batch functions apply the same operation to all pairs of
+  intervals of two batches. They switch the rounding mode once per batch
+  instead of twice per operation, and they loop over plain arrays, so the
+  compiler can vectorize the loops. Sums and differences additionally have
+  an AVX2 code path that is used if the CPU supports it. The results are
+  exactly those of the corresponding operators in interval.h. Divisions
+  store the inverses of rhs in scratch, so callers that keep scratch
+  around do not allocate once its capacity suffices.
+*/
+struct IntervalBatch {
+	enum {LEFT_OPEN = 1, RIGHT_OPEN = 2};
+
+	std::vector<ap_float> left;
+	std::vector<ap_float> right;
+	std::vector<unsigned char> open;
+
+	size_t size() const {return left.size();}
+	void clear() {
+		left.clear();
+		right.clear();
+		open.clear();
+	}
+	void resize(size_t size) {
+		left.resize(size);
+		right.resize(size);
+		open.resize(size);
+	}
+	void push_back(const Interval &interval) {
+		left.push_back(interval.left);
+		right.push_back(interval.right);
+		open.push_back((interval.left_open ? LEFT_OPEN : 0) |
+					   (interval.right_open ? RIGHT_OPEN : 0));
+	}
+	Interval get(size_t i) const {
+		return Interval(left[i], right[i], open[i] & LEFT_OPEN, open[i] & RIGHT_OPEN);
+	}
+};
+
+void compute_batch(const IntervalBatch &lhs, f_operator fop,
+				   const IntervalBatch &rhs, IntervalBatch &result,
+				   IntervalBatch &scratch);
+void compute_batch(const IntervalBatch &lhs, cal_operator calop,
+				   const IntervalBatch &rhs, IntervalBatch &result,
+				   IntervalBatch &scratch);
+
+/*
+  Evaluates a sequence of operations with different operators (f_operator
+  or cal_operator). The operations are grouped by operator and each group
+  is evaluated with one call of compute_batch. The results are accessed by
+  the position of the operation in the sequence.
+*/
+template<typename Operator, int NUM_OPERATORS>
+class IntervalOperations {
+	IntervalBatch lhs[NUM_OPERATORS];
+	IntervalBatch rhs[NUM_OPERATORS];
+	IntervalBatch results[NUM_OPERATORS];
+	IntervalBatch scratch;
+	// Operator and index in the group of each operation.
+	std::vector<std::pair<int, int>> positions;
+public:
+	void clear() {
+		for (int op = 0; op < NUM_OPERATORS; ++op) {
+			lhs[op].clear();
+			rhs[op].clear();
+		}
+		positions.clear();
+	}
+
+	void add(const Interval &left, Operator op, const Interval &right) {
+		positions.emplace_back(op, lhs[op].size());
+		lhs[op].push_back(left);
+		rhs[op].push_back(right);
+	}
+
+	void compute() {
+		for (int op = 0; op < NUM_OPERATORS; ++op) {
+			if (lhs[op].size() > 0)
+				compute_batch(lhs[op], static_cast<Operator>(op), rhs[op], results[op],
+							  scratch);
+		}
+	}
+
+	size_t size() const {return positions.size();}
+
+	Interval get_result(size_t i) const {
+		return results[positions[i].first].get(positions[i].second);
+	}
+};
+
+typedef IntervalOperations<f_operator, decrease + 1> IntervalEffects;
+typedef IntervalOperations<cal_operator, divi + 1> IntervalAssignments;
+
+#endif
@@ -13,6 +13,7 @@
 #include "../globals.h"
 #include "../options/options.h"
 #include "../task_proxy.h"
+#include "../task_tools.h"
 #include "../utils/collections.h"
 
 using namespace std;
@@ -96,9 +97,12 @@ Proposition* IntervalRelaxationHeuristic::get_proposition(
 
 void IntervalRelaxationHeuristic::setup_exploration(const State& state) {
 //	cout << "Preparing heuristic for next calculation " << endl;
-	planning_graph.clear();
 	applicable_operators.clear();
+	applicable_numeric_operators.clear();
+	num_applied_numeric_operators = 0;
 	applicable_axioms.clear();
+	satisfied_comparison_axioms.clear();
+	comparison_axiom_is_satisfied.assign(numeric_axioms.size(), false);
 
     for (vector<Proposition> &props_of_var : propositions) {
         for (Proposition &prop : props_of_var) {
@@ -127,21 +131,124 @@ void IntervalRelaxationHeuristic::setup_exploration(const State& state) {
         handle_prop(init_prop, 0, 0, 0, dummy);
     }
 
+	// Operators with preconditions were enqueued by handle_prop.
 	for (size_t i = 0; i < unary_operators.size(); ++i) {
-		if (unary_operators[i].unsatisfied_preconditions == 0) {
-//			cout << "Operator without (missing) precons" << unary_operators[i].str() << endl;
-			applicable_operators.push_back(&unary_operators[i]);
-		}
+		if (unary_operators[i].precondition.empty())
+			enqueue_operator(&unary_operators[i]);
 	}
 	for (size_t i = 0; i < unary_axioms.size(); ++i) {
-		if (unary_axioms[i].unsatisfied_preconditions == 0) {
-//			cout << "Axiom without (missing) precons" << unary_axioms[i].str() << endl;
+		if (unary_axioms[i].precondition.empty())
 			applicable_axioms.push_back(&unary_axioms[i]);
+	}
+
+    planning_graph.reset(state);
+}
+
+void IntervalRelaxationHeuristic::enqueue_operator(UnaryOperator *op) {
+	if (op->is_numeric_operator())
+		applicable_numeric_operators.push_back(op);
+	else
+		applicable_operators.push_back(op);
+}
+
+void IntervalRelaxationHeuristic::apply_numeric_operators() {
+	/*
+	  An operator whose inputs did not change in the last layer would
+	  compute the same interval as before, which is already contained in
+	  the current interval of the affected variable.
+	*/
+	layer_numeric_operators.clear();
+	layer_effects.clear();
+	for (size_t i = 0; i < applicable_numeric_operators.size(); ++i) {
+		UnaryOperator *op = applicable_numeric_operators[i];
+		int aff_var = op->effect.aff_variable_index;
+		int ass_var = op->effect.val_or_ass_var_index;
+		if (i < num_applied_numeric_operators &&
+			!planning_graph.is_changed_in_last_layer(aff_var) &&
+			!planning_graph.is_changed_in_last_layer(ass_var))
+			continue;
+		layer_numeric_operators.push_back(op);
+		layer_effects.add(planning_graph.get_val(aff_var), op->effect.assign_type,
+						  planning_graph.get_val(ass_var));
+	}
+	layer_effects.compute();
+	for (size_t i = 0; i < layer_numeric_operators.size(); ++i) {
+		UnaryOperator *op = layer_numeric_operators[i];
+		int aff_var = op->effect.aff_variable_index;
+		Interval newval = layer_effects.get_result(i);
+		ap_float cost = update_cost(planning_graph.get_cost(aff_var),
+									planning_graph.get_cost(op->effect.val_or_ass_var_index));
+		cost += op->base_cost; // implicit numeric precondition cost
+		cost = update_cost(cost, op->precondition_cost); // cost of "regular" preconditions
+		planning_graph.new_val_for(aff_var, newval, op, cost);
+	}
+	num_applied_numeric_operators = applicable_numeric_operators.size();
+}
+
+void IntervalRelaxationHeuristic::apply_numeric_axioms(int &unsolved_goals) {
+	int layer = planning_graph.size();
+	// Collect the axioms with an input that changed in the last layer.
+	triggered_numeric_axioms.clear();
+	for (int var : planning_graph.get_changed_vars()) {
+		for (int i : numeric_axioms_by_input[var]) {
+			if (!numeric_axiom_is_triggered[i]) {
+				numeric_axiom_is_triggered[i] = true;
+				triggered_numeric_axioms.push_back(i);
+			}
+		}
+	}
+	sort(triggered_numeric_axioms.begin(), triggered_numeric_axioms.end());
+
+	layer_assignments.clear();
+	for (int i : triggered_numeric_axioms) {
+		auto ax = &numeric_axioms[i];
+		if (ax->is_assignment_axiom())
+			layer_assignments.add(planning_graph.get_val(ax->axiom_left_var), ax->ass_ax_op,
+								  planning_graph.get_val(ax->axiom_right_var));
+	}
+	layer_assignments.compute();
+
+	size_t num_assignments = 0;
+	for (int i : triggered_numeric_axioms) {
+		auto ax = &numeric_axioms[i];
+		Interval leftval = planning_graph.get_val(ax->axiom_left_var);
+		Interval rightval = planning_graph.get_val(ax->axiom_right_var);
+		ap_float leftcost = planning_graph.get_cost(ax->axiom_left_var);
+		ap_float rightcost = planning_graph.get_cost(ax->axiom_right_var);
+		ap_float cost = max(leftcost, rightcost);
+		if (ax->is_assignment_axiom()) {
+			Interval newval = layer_assignments.get_result(num_assignments++);
+//			cout << leftval << " " << ax.ass_ax_op << " " <<  rightval << " = " << newval << endl;
+			planning_graph.new_val_for(ax->effect.aff_variable_index, newval, ax, cost);
+		} else {
+			bool result = relaxed_compare(leftval, ax->comp_ax_op, rightval);
+			//			cout << leftval << " " << ax.comp_ax_op << " " <<  rightval << " = " << (result?"TRUE":"FALSE") << endl;
+			if (result) {
+				if (!comparison_axiom_is_satisfied[i])
+					satisfied_comparison_axioms.push_back(i);
+				comparison_axiom_cost[i] = cost;
+				Proposition *prop = &propositions[ax->effect.aff_variable_index][ax->effect.val_or_ass_var_index];
+				handle_prop(prop, cost, layer, ax, unsolved_goals);
+			}
+			comparison_axiom_is_satisfied[i] = result;
 		}
 	}
 
-    NumericState nstate = NumericState(state);
-    planning_graph.push_back(nstate);
+	/*
+	  A satisfied comparison axiom with unchanged inputs reaches its
+	  proposition with the same cost as before. This does not change the
+	  cost of the proposition, but the layer in which it is reached.
+	*/
+	for (int i : satisfied_comparison_axioms) {
+		if (comparison_axiom_is_satisfied[i] && !numeric_axiom_is_triggered[i]) {
+			auto ax = &numeric_axioms[i];
+			Proposition *prop = &propositions[ax->effect.aff_variable_index][ax->effect.val_or_ass_var_index];
+			handle_prop(prop, comparison_axiom_cost[i], layer, ax, unsolved_goals);
+		}
+	}
+
+	for (int i : triggered_numeric_axioms)
+		numeric_axiom_is_triggered[i] = false;
 }
 
 void IntervalRelaxationHeuristic::relaxed_exploration() {
@@ -149,92 +256,40 @@ void IntervalRelaxationHeuristic::relaxed_exploration() {
     for (auto goal : goal_propositions)
     	if (goal->reached_in_layer == 0) --unsolved_goals; // initially solved goals
     while (unsolved_goals > 0) {
-    	NumericState nextState = planning_graph.back().duplicate();
-        //cout << "Phase " << planning_graph.size() << ", applying " << applicable_operators.size() << " operators" << endl;
-    	auto it = applicable_operators.begin();
-    	while (it != applicable_operators.end()) {
-    		auto op = (*it);
-            //cout << "applying " << op->str() << endl;
-    		if (op->is_numeric_operator()) {
-    			Interval oldval = planning_graph.back().get_val(op->effect.aff_variable_index);
-    			ap_float aff_cost = planning_graph.back().get_cost(op->effect.aff_variable_index);
-    			Interval ass_val =  planning_graph.back().get_val(op->effect.val_or_ass_var_index);
-    			ap_float ass_cost = planning_graph.back().get_cost(op->effect.val_or_ass_var_index);
-    			Interval newval = compute(oldval, op->effect.assign_type, ass_val);
-                //cout << oldval << " " << op->effect.assign_type << " " <<  ass_val << " = " << newval << endl;
-    			ap_float cost = update_cost(aff_cost, ass_cost);
-    			cost += op->base_cost; // implicit numeric precondition cost
-    			cost = update_cost(cost, op->precondition_cost); // cost of "regular" preconditions
-    			nextState.new_val_for(op->effect.aff_variable_index, newval, op, cost);
-    			++it;
-    		} else {
-    			Proposition *prop = &propositions[op->effect.aff_variable_index][op->effect.val_or_ass_var_index];
-    			handle_prop(prop, op->cost(), planning_graph.size(), op, unsolved_goals);
-    			it = applicable_operators.erase(it);
-    		}
+    	int layer = planning_graph.size();
+        //cout << "Phase " << layer << ", applying " << applicable_operators.size() << " operators" << endl;
+    	// Operators that become applicable are applied in the same layer.
+    	for (size_t i = 0; i < applicable_operators.size(); ++i) {
+    		UnaryOperator *op = applicable_operators[i];
+    		Proposition *prop = &propositions[op->effect.aff_variable_index][op->effect.val_or_ass_var_index];
+    		handle_prop(prop, op->cost(), layer, op, unsolved_goals);
     	}
-        //cout << "Phase " << planning_graph.size() << ", done with ops, " << applicable_operators.size() << " left" << endl;
-        //cout << "Phase " << planning_graph.size() << ", applying numeric axioms ("<< numeric_axioms.size() <<")" << endl;
-    	for (size_t i = 0; i < numeric_axioms.size(); ++i) {
-    		auto ax = &numeric_axioms[i];
-    		if (ax->is_assignment_axiom()) {
-//    			cout << "have to handle ass axiom " << ax.axiom_left_var << ax.ass_ax_op << ax.axiom_right_var << endl;
-    			Interval leftval = planning_graph.back().get_val(ax->axiom_left_var);
-    			Interval rightval = planning_graph.back().get_val(ax->axiom_right_var);
-    			ap_float leftcost = planning_graph.back().get_cost(ax->axiom_left_var);
-    			ap_float rightcost = planning_graph.back().get_cost(ax->axiom_right_var);
-
-    			Interval newval = compute(leftval, ax->ass_ax_op, rightval);
-//    			cout << leftval << " " << ax.ass_ax_op << " " <<  rightval << " = " << newval << endl;
-    			ap_float cost = max(leftcost, rightcost);
-    			nextState.new_val_for(ax->effect.aff_variable_index, newval, ax, cost);
-//    			cout << "Applied Assignment Axiom, #achievers of variable " << ax->effect.aff_variable_index << " is " << nextState.get_achievers(ax->effect.aff_variable_index).size() << endl;
-    		} else {
-//    			cout << "have to handle comp axiom " << ax.axiom_left_var << ax.comp_ax_op << ax.axiom_right_var << endl;
-    			Interval leftval = planning_graph.back().get_val(ax->axiom_left_var);
-    			Interval rightval = planning_graph.back().get_val(ax->axiom_right_var);
-    			ap_float leftcost = planning_graph.back().get_cost(ax->axiom_left_var);
-    			ap_float rightcost = planning_graph.back().get_cost(ax->axiom_right_var);
-    			bool result = relaxed_compare(leftval, ax->comp_ax_op, rightval);
-    			//    			cout << leftval << " " << ax.comp_ax_op << " " <<  rightval << " = " << (result?"TRUE":"FALSE") << endl;
-    			if (result) {
-    				ap_float cost = max(leftcost, rightcost);
-    				Proposition *prop = &propositions[ax->effect.aff_variable_index][ax->effect.val_or_ass_var_index];
-    				handle_prop(prop, cost, planning_graph.size(), ax, unsolved_goals);
-    			}
-    		}
-    	}
-//    	cout << "Phase " << planning_graph.size() << ", applying propositional axioms (" << applicable_axioms.size()<<")" << endl;
-    	auto it2 = applicable_axioms.begin();
-    	while (it2 != applicable_axioms.end()) {
-    		auto ax = (*it2);
-//    		cout << "looking at you axiom " << ax->str() << " missing " << ax->unsatisfied_preconditions << endl;
+    	applicable_operators.clear();
+    	apply_numeric_operators();
+        //cout << "Phase " << layer << ", applying numeric axioms ("<< numeric_axioms.size() <<")" << endl;
+    	apply_numeric_axioms(unsolved_goals);
+//    	cout << "Phase " << layer << ", applying propositional axioms (" << applicable_axioms.size()<<")" << endl;
+    	for (size_t i = 0; i < applicable_axioms.size(); ++i) {
+    		UnaryOperator *ax = applicable_axioms[i];
     		assert (ax->unsatisfied_preconditions == 0);
     		Proposition * ax_prop = &propositions[ax->effect.aff_variable_index][ax->effect.val_or_ass_var_index];
-//    		cout << "prop " << ax_prop->id << ": " << g_fact_names[ax->effect.aff_variable_index][ax->effect.val_or_ass_var_index] <<  " was reached in layer " << ax_prop->reached_in_layer << endl;
-    		handle_prop(ax_prop, ax->precondition_cost, planning_graph.size(), ax, unsolved_goals);
-    		it2 = applicable_axioms.erase(it2);
+    		handle_prop(ax_prop, ax->precondition_cost, layer, ax, unsolved_goals);
     	}
-//    	cout << "Phase " << planning_graph.size() << ", done propositional axioms ("<< applicable_axioms.size() <<") left" << endl;
-//    	cout << "Phase " << planning_graph.size() << " done. Missing goals : " << unsolved_goals << endl;
-//    	for (auto goal: goal_propositions) {
-//    		cout << "Goal " << debug_fact_names[goal->id] << ((goal->reached_in_layer >= 0)?" achieved":" missing") << endl;
-//    		for (auto ax : unary_axioms) {
-//    			if (propositions[ax.effect.aff_variable_index][ax.effect.val_or_ass_var_index].id == goal->id) {
-//    				cout << "Could be achieved with " << ax.str() << " with preconditions, missing " << ax.unsatisfied_preconditions << endl;
-//    				for (auto precon : ax.precondition)
-//    					cout << debug_fact_names[precon->id] << ((precon->reached_in_layer >= 0)?" achieved":" missing") << endl;
-//
-//    			}
-//    		}
-//    	}
-//    	cout << "Phase " << planning_graph.size() << ", relaxed state = " << endl;
-//    	nextState.dump();
-    	planning_graph.push_back(nextState);
-//    	planning_graph.back().dump();
+    	applicable_axioms.clear();
+//    	cout << "Phase " << layer << " done. Missing goals : " << unsolved_goals << endl;
+    	planning_graph.close_layer();
+//    	planning_graph.dump(layer);
     }
 }
 
+bool IntervalRelaxationHeuristic::get_relevant_variables(
+		vector<int> &variables, vector<int> &numeric_variables) const {
+	// Operators that do not affect relevant variables never contribute to
+	// reaching the goal in the relaxed exploration.
+	compute_goal_relevant_variables(task_proxy, variables, numeric_variables);
+	return true;
+}
+
 bool IntervalRelaxationHeuristic::dead_ends_are_reliable() const {
 	return !has_axioms();
 }
@@ -290,6 +345,16 @@ void IntervalRelaxationHeuristic::initialize() {
         for (size_t j = 0; j < op->precondition.size(); ++j)
             op->precondition[j]->precondition_of.push_back(op);
     }
+
+    numeric_axioms_by_input.resize(task_proxy.get_numeric_variables().size());
+    for (size_t i = 0; i < numeric_axioms.size(); ++i) {
+        const UnaryOperator &ax = numeric_axioms[i];
+        numeric_axioms_by_input[ax.axiom_left_var].push_back(i);
+        if (ax.axiom_right_var != ax.axiom_left_var)
+            numeric_axioms_by_input[ax.axiom_right_var].push_back(i);
+    }
+    numeric_axiom_is_triggered.resize(numeric_axioms.size(), false);
+    comparison_axiom_cost.resize(numeric_axioms.size(), 0);
 }
 
 NumericState::NumericState(const State& state) {
@@ -323,6 +388,87 @@ void NumericState::new_val_for(size_t index, Interval new_val,
 	}
 }
 
+void NumericLayers::reset(const State &state) {
+	int num_vars = g_numeric_var_names.size();
+	vals.resize(num_vars);
+	costs.assign(num_vars, 0); // state constructor -> initial state
+	next_achievers.resize(num_vars);
+	changes.resize(num_vars);
+	achiever_pool.clear();
+	changed_vars.clear();
+	is_changed.assign(num_vars, true);
+	for (int var = 0; var < num_vars; ++var) {
+		vals[var] = Interval(state.nval(var));
+		changes[var].clear();
+		changes[var].push_back(Change{0, vals[var], 0, 0});
+		changed_vars.push_back(var);
+	}
+	next_vals = vals;
+	next_costs = costs;
+	num_layers = 1;
+}
+
+void NumericLayers::new_val_for(int var, Interval new_val,
+		UnaryOperator *achiever, ap_float cost) {
+	Interval convex_union = next_vals[var] || new_val;
+	if (convex_union.extends(next_vals[var])) {
+		if (next_achievers[var].empty()) {
+			next_costs[var] = cost;
+			next_changed_vars.push_back(var);
+		} else {
+			next_costs[var] = min(next_costs[var], cost);
+		}
+		next_vals[var] = convex_union;
+		next_achievers[var].push_back(achiever);
+	}
+}
+
+void NumericLayers::close_layer() {
+	for (int var : changed_vars)
+		is_changed[var] = false;
+	changed_vars.swap(next_changed_vars);
+	next_changed_vars.clear();
+	for (int var : changed_vars) {
+		is_changed[var] = true;
+		vals[var] = next_vals[var];
+		costs[var] = next_costs[var];
+		int achievers_begin = achiever_pool.size();
+		achiever_pool.insert(achiever_pool.end(),
+			next_achievers[var].begin(), next_achievers[var].end());
+		next_achievers[var].clear();
+		changes[var].push_back(Change{num_layers, vals[var], achievers_begin,
+			static_cast<int>(achiever_pool.size())});
+	}
+	++num_layers;
+}
+
+const NumericLayers::Change &NumericLayers::get_change(int layer, int var) const {
+	assert(layer < num_layers);
+	const vector<Change> &var_changes = changes[var];
+	// Find the last change up to the given layer.
+	auto it = upper_bound(var_changes.begin(), var_changes.end(), layer,
+		[](int l, const Change &change) {return l < change.layer;});
+	assert(it != var_changes.begin());
+	return *(it - 1);
+}
+
+pair<NumericLayers::AchieverIterator, NumericLayers::AchieverIterator>
+NumericLayers::get_achievers(int layer, int var) const {
+	const Change &change = get_change(layer, var);
+	if (change.layer != layer)
+		return make_pair(achiever_pool.end(), achiever_pool.end());
+	return make_pair(achiever_pool.begin() + change.achievers_begin,
+		achiever_pool.begin() + change.achievers_end);
+}
+
+void NumericLayers::dump(int layer) const {
+	for (int var = 0; var < get_num_variables(); ++var) {
+		auto achievers = get_achievers(layer, var);
+		cout << "v_" << var << " = " << get_val(layer, var) << " #a= "
+			 << (achievers.second - achievers.first) << "\t " << g_numeric_var_names[var] << endl;
+	}
+}
+
 std::string UnaryOperator::str() {
 	stringstream ss;
 	if (operator_no == -1) {
@@ -394,7 +540,7 @@ void IntervalRelaxationHeuristic::handle_prop(Proposition* prop, ap_float distan
 				if (unary_op->operator_no < 0)
 					applicable_axioms.push_back(unary_op);
 				else
-					applicable_operators.push_back(unary_op);
+					enqueue_operator(unary_op);
 			}
 		}
 		prop->reached_by = achiever;
@@ -3,8 +3,10 @@
 
 #include "../heuristic.h"
 #include "interval.h"
+#include "interval_batch.h"
 #include <vector>
 #include <list>
+#include <utility>
 
 class FactProxy;
 class GlobalState;
@@ -97,6 +99,62 @@ public:
 	void dump();
 };
 
+/*
+  Values of the numeric variables in all layers of the relaxed planning
+  graph. The values and costs of the last layer and of the layer under
+  construction are stored in flat arrays. For the earlier layers, we only
+  store the changes of each variable (the delta of each layer), together
+  with the operators that extended the interval in that layer.
+*/
+class NumericLayers {
+	struct Change {
+		int layer;
+		Interval val;
+		int achievers_begin; // index into achiever_pool
+		int achievers_end;
+	};
+	// Values and costs of the last layer.
+	std::vector<Interval> vals;
+	std::vector<ap_float> costs;
+	// Values, costs and achievers of the layer under construction.
+	std::vector<Interval> next_vals;
+	std::vector<ap_float> next_costs;
+	std::vector<std::vector<UnaryOperator *>> next_achievers;
+	std::vector<int> next_changed_vars;
+	// Variables whose value changed in the last layer (all variables in layer 0).
+	std::vector<int> changed_vars;
+	std::vector<bool> is_changed;
+	// Changes of each variable, ordered by layer. The first one is layer 0.
+	std::vector<std::vector<Change>> changes;
+	std::vector<UnaryOperator *> achiever_pool;
+	int num_layers;
+	const Change &get_change(int layer, int var) const;
+public:
+	typedef std::vector<UnaryOperator *>::const_iterator AchieverIterator;
+
+	NumericLayers() : num_layers(0) {}
+	// Discards all layers and creates layer 0 from the given state.
+	void reset(const State &state);
+	// Records an update of the layer under construction.
+	void new_val_for(int var, Interval new_val, UnaryOperator *achiever, ap_float cost);
+	// Makes the layer under construction the last layer.
+	void close_layer();
+
+	// Access to the last layer.
+	Interval get_val(int var) const {return vals[var];}
+	ap_float get_cost(int var) const {return costs[var];}
+	bool is_changed_in_last_layer(int var) const {return is_changed[var];}
+	const std::vector<int> &get_changed_vars() const {return changed_vars;}
+
+	// Access to all layers.
+	Interval get_val(int layer, int var) const {return get_change(layer, var).val;}
+	// The operators that extended the interval of var in the given layer.
+	std::pair<AchieverIterator, AchieverIterator> get_achievers(int layer, int var) const;
+	int size() const {return num_layers;}
+	int get_num_variables() const {return vals.size();}
+	void dump(int layer) const;
+};
+
 class IntervalRelaxationHeuristic : public Heuristic {
     void build_unary_operators(const OperatorProxy &op, int operator_no);
     void build_unary_axioms(const OperatorProxy &ax, int operator_no);
@@ -108,11 +166,41 @@ protected:
     std::vector<UnaryOperator> unary_axioms;
     std::vector<std::vector<Proposition>> propositions;
     std::vector<Proposition *> goal_propositions;
-    std::vector<NumericState> planning_graph;
-    std::list<UnaryOperator *> applicable_operators;
-    std::list<UnaryOperator *> applicable_axioms;
+    NumericLayers planning_graph;
+    /*
+      Operators and axioms with satisfied preconditions in the order in which
+      they became applicable. Propositional operators and logic axioms are
+      applied once, numeric operators in every layer (but only if their
+      input changed in the last layer or they are new).
+    */
+    std::vector<UnaryOperator *> applicable_operators;
+    std::vector<UnaryOperator *> applicable_numeric_operators;
+    size_t num_applied_numeric_operators;
+    std::vector<UnaryOperator *> applicable_axioms;
+    /*
+      The numeric operators and assignment axioms of a layer only read the
+      values of the previous layer, so their effects are computed together
+      (see IntervalOperations).
+    */
+    std::vector<UnaryOperator *> layer_numeric_operators;
+    IntervalEffects layer_effects;
+    IntervalAssignments layer_assignments;
+    /*
+      The numeric axioms are re-evaluated only if one of their inputs changed
+      in the last layer. Satisfied comparison axioms that are not
+      re-evaluated still reach their proposition with their last cost.
+    */
+    std::vector<std::vector<int>> numeric_axioms_by_input;
+    std::vector<int> triggered_numeric_axioms;
+    std::vector<bool> numeric_axiom_is_triggered;
+    std::vector<int> satisfied_comparison_axioms;
+    std::vector<bool> comparison_axiom_is_satisfied;
+    std::vector<ap_float> comparison_axiom_cost;
     std::vector<std::string> debug_fact_names;
 	void setup_exploration(const State &state);
+	void enqueue_operator(UnaryOperator *op);
+	void apply_numeric_operators();
+	void apply_numeric_axioms(int &unsolved_goals);
 	void relaxed_exploration();
     Proposition *get_proposition(const FactProxy &fact);
 	UnaryEffect get_effect(EffectProxy effect);
@@ -121,6 +209,8 @@ protected:
     virtual void initialize();
     virtual ap_float compute_heuristic(const GlobalState &state) = 0;
     virtual ap_float update_cost(ap_float old_cost, ap_float new_cost) = 0;
+    virtual bool get_relevant_variables(std::vector<int> &variables,
+                                        std::vector<int> &numeric_variables) const override;
 public:
 	IntervalRelaxationHeuristic(const options::Options &options);
 	virtual ~IntervalRelaxationHeuristic();
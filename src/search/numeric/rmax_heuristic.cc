@@ -62,7 +62,7 @@ namespace rmax_heuristic {
         closed.assign(ops.size(),false);
         action_comp_number_execution.assign(ops.size(),vector<double>(numeric_task.get_n_conditions(),-1));
 
-        HeapQueue<int> a_plus; // cannot use adaptive queue when costs are non integer
+        a_plus.clear();
         set<int> reachable;
         
         //update initial state
@@ -205,7 +205,7 @@ namespace rmax_heuristic {
         return max_float ;
     }
     
-    void RMaxHeuristic::update_reachable_conditions_actions(const State &s_0, int gr_id, HeapQueue<int>& a_plus){
+    void RMaxHeuristic::update_reachable_conditions_actions(const State &s_0, int gr_id, RadixQueue<int>& a_plus){
         // preconditions
         OperatorProxy gr = task_proxy.get_operators()[gr_id];
         double c_a = gr.get_cost();
@@ -263,7 +263,7 @@ namespace rmax_heuristic {
     }
 
     
-    void RMaxHeuristic::update_reachable_actions(int gr_id, int cond, HeapQueue<int>& a_plus){
+    void RMaxHeuristic::update_reachable_actions(int gr_id, int cond, RadixQueue<int>& a_plus){
         set<int> &set = condition_to_action[cond];
         //cout << "set size " << set.size() << " " << cond << endl;
         for (int gr2 : set) {
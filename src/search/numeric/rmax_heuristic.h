@@ -30,13 +30,14 @@ protected:
     vector<double> action_dist;
     vector<bool> is_init_state; // TODO erease, for debug only
     vector<bool> closed;
+    RadixQueue<int> a_plus; // cannot use adaptive queue when costs are non integer
     
     vector<set<int>> possible_achievers; // index: action, value, set of numeric conditions that can be achieved by the action
     vector<set<int>> possible_achievers_inverted; // index: numeric condition, value, set actions that can modify the numeric achiever
     vector<set<int>> all_achievers;
     numeric_helper::NumericTaskProxy numeric_task;
-    void update_reachable_conditions_actions(const State &s_0, int gr, HeapQueue<int>& a_plus);
-    void update_reachable_actions(int gr, int cond, HeapQueue<int>& a_plus);
+    void update_reachable_conditions_actions(const State &s_0, int gr, RadixQueue<int>& a_plus);
+    void update_reachable_actions(int gr, int cond, RadixQueue<int>& a_plus);
     vector<vector<double>> net_effects; // index: action, index n_condition, value: net effect;
     vector<vector<double>> action_comp_number_execution;
     double check_conditions(int gr_id);
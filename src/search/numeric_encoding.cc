@@ -0,0 +1,130 @@
+#include "numeric_encoding.h"
+
+#include "global_operator.h"
+#include "int_packer.h"
+
+#include "utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+const container_int NumericEncoding::INTEGER_ESCAPE_BIT;
+const container_int NumericEncoding::INTEGER_OFFSET;
+const container_int NumericEncoding::DICTIONARY_RANGE;
+
+NumericEncoding::NumericEncoding() {
+    compute_types();
+    compute_finite_values();
+}
+
+void NumericEncoding::compute_types() {
+    int num_vars = g_numeric_var_types.size();
+    vector<bool> constant_operands(num_vars, true);
+    vector<bool> integral_operands(num_vars, true);
+    vector<bool> only_assignments(num_vars, true);
+    for (const GlobalOperator &op : g_operators) {
+        for (const AssignEffect &eff : op.get_assign_effects()) {
+            int var = eff.aff_var;
+            if (g_numeric_var_types[eff.ass_var] != constant) {
+                constant_operands[var] = false;
+                continue;
+            }
+            ap_float operand = g_initial_state_numeric[eff.ass_var];
+            if (eff.fop != assign)
+                only_assignments[var] = false;
+            if (eff.fop == scale_down || !is_small_integer(operand))
+                integral_operands[var] = false;
+        }
+    }
+
+    types.assign(num_vars, RAW);
+    for (int var = 0; var < num_vars; ++var) {
+        if (g_numeric_var_types[var] != regular || !constant_operands[var])
+            continue;
+        if (only_assignments[var])
+            types[var] = FINITE;
+        else if (integral_operands[var] && is_small_integer(g_initial_state_numeric[var]))
+            types[var] = INTEGER;
+        else
+            types[var] = DICTIONARY;
+    }
+}
+
+void NumericEncoding::compute_finite_values() {
+    /*
+      The table is shared by all finite variables. Apart from saving memory,
+      this allows symmetry reduction to move values between variables.
+    */
+    for (size_t var = 0; var < types.size(); ++var) {
+        if (g_numeric_var_types[var] == regular && types[var] == FINITE)
+            finite_values.push_back(g_initial_state_numeric[var]);
+    }
+    for (const GlobalOperator &op : g_operators) {
+        for (const AssignEffect &eff : op.get_assign_effects()) {
+            if (types[eff.aff_var] == FINITE)
+                finite_values.push_back(g_initial_state_numeric[eff.ass_var]);
+        }
+    }
+    sort(finite_values.begin(), finite_values.end());
+    finite_values.erase(unique(finite_values.begin(), finite_values.end()),
+                        finite_values.end());
+}
+
+void NumericEncoding::append_ranges(vector<container_int> &ranges) const {
+    for (size_t var = 0; var < types.size(); ++var) {
+        if (g_numeric_var_types[var] != regular)
+            continue;
+        switch (types[var]) {
+        case FINITE:
+            // Avoid zero-bit variables, which the packer cannot handle.
+            ranges.push_back(max<container_int>(2, finite_values.size()));
+            break;
+        case INTEGER:
+        case DICTIONARY:
+            ranges.push_back(DICTIONARY_RANGE);
+            break;
+        case RAW:
+            ranges.push_back(numeric_limits<container_int>::max());
+            break;
+        }
+    }
+}
+
+container_int NumericEncoding::encode_finite(ap_float value) const {
+    auto it = lower_bound(finite_values.begin(), finite_values.end(), value);
+    if (it == finite_values.end() || *it != value) {
+        cerr << "Numeric value " << value << " is not contained in the "
+             << "statically computed value table." << endl
+             << "Terminating." << endl;
+        utils::exit_with(utils::ExitCode::CRITICAL_ERROR);
+    }
+    return it - finite_values.begin();
+}
+
+void NumericEncoding::dump_statistics() const {
+    int num_of_type[4] = {0, 0, 0, 0};
+    int num_bits = 0;
+    int num_raw_bits = 0;
+    vector<container_int> ranges;
+    append_ranges(ranges);
+    for (container_int range : ranges)
+        num_bits += IntPacker::get_bit_size_for_range(range);
+    for (size_t var = 0; var < types.size(); ++var) {
+        if (g_numeric_var_types[var] == regular) {
+            ++num_of_type[types[var]];
+            num_raw_bits += sizeof(container_int) * 8;
+        }
+    }
+    cout << "Numeric encoding: "
+         << num_of_type[FINITE] << " finite ("
+         << finite_values.size() << " values), "
+         << num_of_type[INTEGER] << " integer, "
+         << num_of_type[DICTIONARY] << " dictionary, "
+         << num_of_type[RAW] << " raw variables" << endl;
+    cout << "Numeric bits per state: " << num_bits
+         << " (raw encoding: " << num_raw_bits << ")" << endl;
+}
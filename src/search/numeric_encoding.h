@@ -0,0 +1,74 @@
+#ifndef NUMERIC_ENCODING_H
+#define NUMERIC_ENCODING_H
+
+#include "globals.h"
+
+#include <vector>
+
+/*
+  Decides how the regular numeric variables are stored in the packed state
+  buffer. Storing every variable as a raw 64-bit double costs a full bin per
+  fluent, so we analyse the assignment effects of all operators once and pick
+  the most compact encoding that is still exact:
+
+  FINITE      All effects on the variable assign constants, so the variable
+              only takes its initial value or one of the assigned constants.
+              All finite variables share one sorted value table and store an
+              index into it, using as few bits as possible.
+  INTEGER     The initial value is integral and all effects add, subtract,
+              multiply by or assign integral constants. Values in
+              [-2^30, 2^30) are stored directly in 31 bits, all other values
+              escape to the value dictionary of the registry (32 bits).
+  DICTIONARY  All effects have constant operands, so the reached values are
+              likely to repeat across states. The values are stored as 32-bit
+              indices into the value dictionary of the registry.
+  RAW         Everything else (e.g. effects with fluent operands). The bit
+              pattern of the double is stored in a full bin.
+
+  The encoding only depends on the task. The value dictionary is owned by the
+  StateRegistry since its indices are only meaningful within one registry.
+*/
+class NumericEncoding {
+public:
+    enum Type {FINITE, INTEGER, DICTIONARY, RAW};
+
+    // Codes of INTEGER variables with this bit set refer to the dictionary.
+    static const container_int INTEGER_ESCAPE_BIT = 1ULL << 31;
+    static const container_int INTEGER_OFFSET = 1ULL << 30;
+    static const container_int DICTIONARY_RANGE = 1ULL << 32;
+
+private:
+    // Indexed by numeric variable, only meaningful for regular variables.
+    std::vector<Type> types;
+    std::vector<ap_float> finite_values;
+
+    void compute_types();
+    void compute_finite_values();
+public:
+    NumericEncoding();
+
+    Type get_type(int var) const {
+        return types[var];
+    }
+
+    /*
+      Appends the packer ranges of all regular numeric variables in the order
+      in which the state registry assigns their buffer indices.
+    */
+    void append_ranges(std::vector<container_int> &ranges) const;
+
+    container_int encode_finite(ap_float value) const;
+    ap_float decode_finite(container_int code) const {
+        return finite_values[code];
+    }
+
+    static bool is_small_integer(ap_float value) {
+        return value >= -static_cast<ap_float>(INTEGER_OFFSET) &&
+               value < static_cast<ap_float>(INTEGER_OFFSET) &&
+               value == static_cast<ap_float>(static_cast<long long>(value));
+    }
+
+    void dump_statistics() const;
+};
+
+#endif
@@ -57,6 +57,12 @@ namespace lm_cut_numeric_heuristic {
         return total_cost;
     }
 
+    bool LandmarkCutNumericHeuristic::get_relevant_variables(
+        vector<int> &variables, vector<int> &numeric_variables) const {
+        compute_goal_relevant_variables(task_proxy, variables, numeric_variables);
+        return true;
+    }
+
     static Heuristic *_parse(OptionParser &parser) {
         parser.document_synopsis("Landmark-cut heuristic", "");
         parser.document_language_support("action costs", "supported");
@@ -6,6 +6,7 @@
 #include "../heuristic.h"
 
 #include <memory>
+#include <vector>
 
 class GlobalState;
 
@@ -31,6 +32,8 @@ namespace lm_cut_numeric_heuristic {
         virtual void initialize() override;
         virtual ap_float compute_heuristic(const GlobalState &global_state) override;
         ap_float compute_heuristic(const State &state);
+        virtual bool get_relevant_variables(
+            std::vector<int> &variables, std::vector<int> &numeric_variables) const override;
     public:
         explicit LandmarkCutNumericHeuristic(const options::Options &opts);
         virtual ~LandmarkCutNumericHeuristic() override;
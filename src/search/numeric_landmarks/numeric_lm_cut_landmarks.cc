@@ -39,21 +39,21 @@ namespace numeric_lm_cut_heuristic {
         // Build propositions.
         num_propositions = 2; // artificial goal and artificial precondition
         artificial_precondition.is_numeric_condition = false;
-        artificial_precondition.name = "artificial";
         artificial_goal.is_numeric_condition = false;
-        artificial_goal.name = "goal";
         VariablesProxy variables = task_proxy.get_variables();
         n_var = variables.size();
-        propositions.resize(n_var + numeric_task.get_n_numeric_conditions());
-        for (FactProxy fact : variables.get_facts()) {
-            int var_id = fact.get_variable().get_id();
-            RelaxedProposition prop;
-            prop.is_numeric_condition = false;//numeric_task.is_numeric_axiom(fact.get_variable().get_id());
-            prop.id_numeric_condition = -1;
-            prop.name = fact.get_name();
-            propositions[var_id].push_back(prop);
-            ++num_propositions;
+        for (VariableProxy var : variables) {
+            variable_offsets.push_back(propositions.size());
+            for (int value = 0; value < var.get_domain_size(); ++value) {
+                RelaxedProposition prop;
+                prop.is_numeric_condition = false;//numeric_task.is_numeric_axiom(fact.get_variable().get_id());
+                prop.id_numeric_condition = -1;
+                propositions.push_back(prop);
+                proposition_names.push_back(var.get_fact(value).get_name());
+                ++num_propositions;
+            }
         }
+        condition_offset = propositions.size();
 
         OperatorsProxy ops = task_proxy.get_operators();
         AxiomsProxy axioms = task_proxy.get_axioms();
@@ -62,7 +62,6 @@ namespace numeric_lm_cut_heuristic {
             // add numeric conditions
             for (size_t i = 0; i < numeric_task.get_n_numeric_conditions(); i++){
                 //LinearNumericCondition &num_values = numeric_task.get_condition(i);
-                size_t var_id = n_var + i;
                 RelaxedProposition prop;
                 prop.is_numeric_condition = true;
                 prop.id_numeric_condition = i;
@@ -71,8 +70,8 @@ namespace numeric_lm_cut_heuristic {
                 name << "numeric (" << lnc << ")";
                 conditions.push_back(std::move(lnc));
                 epsilons.push_back(numeric_task.get_epsilon(i));
-                prop.name =  name.str();
-                propositions[var_id].push_back(prop);
+                propositions.push_back(prop);
+                proposition_names.push_back(name.str());
                 ++num_propositions;
                 //cout << "adding numeric precondition " << num_values << " : " << num_propositions << " " << var_id << endl;
             }
@@ -177,8 +176,7 @@ namespace numeric_lm_cut_heuristic {
         goal_op_eff.push_back(&artificial_goal);
         /* Use the invalid operator id -1 so accessing
          the artificial operator will generate an error. */
-        string name_goal = "goal";
-        RelaxedOperator goal_op(move(goal_op_pre), move(goal_op_eff), -1, 0, name_goal, false);
+        RelaxedOperator goal_op(move(goal_op_pre), move(goal_op_eff), -1, 0, add_operator_name("goal"), false);
         if (goal_op.preconditions.empty()) goal_op.preconditions.push_back(&artificial_precondition);
         relaxed_operators.push_back(goal_op);
 
@@ -278,7 +276,7 @@ namespace numeric_lm_cut_heuristic {
             std::vector<RelaxedProposition *> conditional_effects;
             int e = numeric_task.get_action_conditional_add_list(op_id)[i];
             std::pair<int, int> e_var_value = numeric_task.get_var_val(e);
-            conditional_effects.push_back(&propositions[e_var_value.first][e_var_value.second]);
+            conditional_effects.push_back(get_proposition(e_var_value.first, e_var_value.second));
 
             std::vector<RelaxedProposition *> extended_precondition = precondition;
             unordered_set<RelaxedProposition *> added_extended_precondition;
@@ -286,7 +284,7 @@ namespace numeric_lm_cut_heuristic {
 
             for (int c : numeric_task.get_action_eff_conditions(op_id)[i]) {
                 std::pair<int, int> c_var_value = numeric_task.get_var_val(c);
-                RelaxedProposition *prop = &propositions[c_var_value.first][c_var_value.second];
+                RelaxedProposition *prop = get_proposition(c_var_value.first, c_var_value.second);
                 if (added_extended_precondition.find(prop) == added_extended_precondition.end()) {
                     extended_precondition.push_back(prop);
                     added_extended_precondition.insert(prop);
@@ -305,27 +303,26 @@ namespace numeric_lm_cut_heuristic {
                 }
             }
 
-            string conditional_name = name + " " + conditional_effects[0]->name;
-            RelaxedOperator conditional_op(move(extended_precondition), move(conditional_effects), op_id, op_cost, conditional_name, true);
+            int name_id = add_operator_name(name + " " + get_name(conditional_effects[0]));
+            RelaxedOperator conditional_op(move(extended_precondition), move(conditional_effects), op_id, op_cost, name_id, true);
             relaxed_operators.push_back(conditional_op);
         }
 
-        RelaxedOperator relaxed_op(move(precondition), move(effects), op_id, op_cost, name, false);
+        RelaxedOperator relaxed_op(move(precondition), move(effects), op_id, op_cost, add_operator_name(move(name)), false);
         if (relaxed_op.preconditions.empty()) relaxed_op.preconditions.push_back(&artificial_precondition);
         relaxed_operators.push_back(relaxed_op);
     }
 
     size_t LandmarkCutLandmarks::add_numeric_condition(LinearNumericCondition lnc) {
         size_t prop_id = conditions.size();
-        size_t var_id = propositions.size();
+        assert(propositions.size() == condition_offset + prop_id);
         RelaxedProposition new_prop;
         new_prop.is_numeric_condition = true;
         new_prop.id_numeric_condition = prop_id;
         stringstream prop_name;
         prop_name << "numeric (" << lnc << ")";
-        new_prop.name = prop_name.str();
-        propositions.push_back(std::vector<RelaxedProposition>());
-        propositions[var_id].push_back(new_prop);
+        propositions.push_back(new_prop);
+        proposition_names.push_back(prop_name.str());
         ++num_propositions;
         conditions.push_back(lnc);
 
@@ -605,7 +602,7 @@ namespace numeric_lm_cut_heuristic {
 
             for (int c : numeric_task.get_action_linear_eff_conditions(op_id)[i]) {
                 std::pair<int, int> c_var_value = numeric_task.get_var_val(c);
-                RelaxedProposition *prop = &propositions[c_var_value.first][c_var_value.second];
+                RelaxedProposition *prop = get_proposition(c_var_value.first, c_var_value.second);
                 if (added_extended_precondition.find(prop) == added_extended_precondition.end()) {
                     extended_precondition.push_back(prop);
                     added_extended_precondition.insert(prop);
@@ -638,10 +635,10 @@ namespace numeric_lm_cut_heuristic {
 
             int lhs = numeric_task.get_action_linear_lhs(op_id)[i];
 
-            string name_plus = op_name + " " + std::to_string(lhs) + " +inf";
+            int name_plus = add_operator_name(op_name + " " + std::to_string(lhs) + " +inf");
             infinite_plus_operators.emplace_back(RelaxedOperator(move(extended_precondition_plus), op_id, op_cost, name_plus, true, true));
 
-            string name_minus = op_name + " " + std::to_string(lhs) + " -inf";
+            int name_minus = add_operator_name(op_name + " " + std::to_string(lhs) + " -inf");
             infinite_minus_operators.emplace_back(RelaxedOperator(move(extended_precondition_minus), op_id, op_cost, name_minus, true, true));
         }
 
@@ -724,7 +721,7 @@ namespace numeric_lm_cut_heuristic {
             auto precondition_1 = build_precondition(op_1, op_1_id);
             auto sose_constants = op_1_to_sose_constants[op_1_id];
             ap_float op_1_cost = op_base_cost[op_1_id];
-            string op_1_name = op_1.get_name();
+            int name_id = add_operator_name(op_1.get_name() + " " + op_name);
 
             std::vector<RelaxedProposition*> eff;
 
@@ -732,7 +729,7 @@ namespace numeric_lm_cut_heuristic {
                 eff.push_back(get_proposition(lnc_id));
 
             RelaxedOperator sose_op(move(precondition_1), precondition, move(eff), move(sose_constants),
-                                    op_1_id, op_id, op_1_cost, op_cost, op_1_name, op_name);
+                                    op_1_id, op_id, op_1_cost, op_cost, name_id);
 
             if (sose_op.preconditions.empty())
                 sose_op.preconditions.push_back(&artificial_precondition);
@@ -776,30 +773,44 @@ namespace numeric_lm_cut_heuristic {
         }
     }
 
+    RelaxedProposition *LandmarkCutLandmarks::get_proposition(int var, int value) {
+        return &propositions[variable_offsets[var] + value];
+    }
+
     RelaxedProposition *LandmarkCutLandmarks::get_proposition(
                                                               const FactProxy &fact) {
-        int var_id = fact.get_variable().get_id();
-        int val = fact.get_value();
-        return &propositions[var_id][val];
+        return get_proposition(fact.get_variable().get_id(), fact.get_value());
     }
     
     RelaxedProposition *LandmarkCutLandmarks::get_proposition(
                                                               const int &n_condition) {
         int propositions_size = propositions.size();
-        if (propositions_size <= n_condition + n_var) std::cout << "wrong vector size " << propositions.size() << " " << n_var << " " << n_condition << endl;
-        if (propositions[n_condition + n_var].size() < 1) std::cout << "no proposition " << endl;
-        return &propositions[n_condition + n_var][0];
+        if (propositions_size <= n_condition + condition_offset) std::cout << "wrong vector size " << propositions.size() << " " << condition_offset << " " << n_condition << endl;
+        return &propositions[n_condition + condition_offset];
+    }
+
+    int LandmarkCutLandmarks::add_operator_name(string &&name) {
+        operator_names.push_back(move(name));
+        return operator_names.size() - 1;
+    }
+
+    const string &LandmarkCutLandmarks::get_name(const RelaxedProposition *prop) const {
+        static const string artificial_precondition_name = "artificial";
+        static const string artificial_goal_name = "goal";
+        if (prop == &artificial_precondition)
+            return artificial_precondition_name;
+        if (prop == &artificial_goal)
+            return artificial_goal_name;
+        return proposition_names[prop - propositions.data()];
     }
     
     // heuristic computation
     void LandmarkCutLandmarks::setup_exploration_queue() {
         priority_queue.clear();
         
-        for (auto &var_props : propositions) {
-            for (RelaxedProposition &prop : var_props) {
-                prop.status = UNREACHED;
-                prop.explored = false;
-            }
+        for (RelaxedProposition &prop : propositions) {
+            prop.status = UNREACHED;
+            prop.explored = false;
         }
         
         artificial_goal.status = UNREACHED;
@@ -819,7 +830,7 @@ namespace numeric_lm_cut_heuristic {
         for (FactProxy init_fact : state) {
             if (numeric_task.is_numeric_axiom(init_fact.get_variable().get_id())) continue;
             enqueue_if_necessary(get_proposition(init_fact), 0);
-            if (debug) std::cout << "initial state: " << get_proposition(init_fact)->name << endl;
+            if (debug) std::cout << "initial state: " << get_name(get_proposition(init_fact)) << endl;
         }
         numeric_initial_state.assign(conditions.size(),0);
         
@@ -863,7 +874,7 @@ namespace numeric_lm_cut_heuristic {
             if (prop_cost < popped_cost)
                 continue;
 
-            if (debug) std::cout << "\tReached " << prop->name << " with cost " << prop->h_max_cost << endl;
+            if (debug) std::cout << "\tReached " << get_name(prop) << " with cost " << prop->h_max_cost << endl;
 
             prop->explored = true;
             const vector<RelaxedOperator *> &triggered_operators = prop->precondition_of;
@@ -887,24 +898,31 @@ namespace numeric_lm_cut_heuristic {
         }
     }
     
+    void LandmarkCutLandmarks::enqueue_changed_operator(const State &state, RelaxedOperator *relaxed_op) {
+        if (!relaxed_op->cost_changed)
+            return;
+        relaxed_op->cost_changed = false;
+        if (relaxed_op->unsatisfied_preconditions == 0) {
+            for (RelaxedProposition *effect : relaxed_op->effects)
+                update_queue(state, relaxed_op->h_max_supporter, effect, relaxed_op);
+        }
+    }
+
     void LandmarkCutLandmarks::first_exploration_incremental(const State &state, vector<RelaxedOperator *> &cut) {
         assert(priority_queue.empty());
         if (debug) std::cout << "  incremental exploration : " << endl;
+        /*
+          Only operators whose cost was reduced can lower the h_max values,
+          since the others are already at the fixpoint. They are pushed in
+          the same order as before, so ties are broken in the same way.
+        */
         for (RelaxedOperator *relaxed_op : cut) {
             if (relaxed_op->original_op_id_1 != -1) {
-                for (RelaxedOperator *relaxed_op_2 : original_to_relaxed_operators[relaxed_op->original_op_id_1]) {
-                    if (relaxed_op_2->unsatisfied_preconditions == 0) {
-                        for (RelaxedProposition *effect : relaxed_op_2->effects)
-                            update_queue(state, relaxed_op_2->h_max_supporter, effect, relaxed_op_2);
-                    }
-                }
-            }
-            for (RelaxedOperator *relaxed_op_2 : original_to_relaxed_operators[relaxed_op->original_op_id_2]) {
-                if (relaxed_op_2->unsatisfied_preconditions == 0) {
-                    for (RelaxedProposition *effect : relaxed_op_2->effects)
-                        update_queue(state, relaxed_op_2->h_max_supporter, effect, relaxed_op_2);
-                }
+                for (RelaxedOperator *relaxed_op_2 : original_to_relaxed_operators[relaxed_op->original_op_id_1])
+                    enqueue_changed_operator(state, relaxed_op_2);
             }
+            for (RelaxedOperator *relaxed_op_2 : original_to_relaxed_operators[relaxed_op->original_op_id_2])
+                enqueue_changed_operator(state, relaxed_op_2);
         }
         if (debug) std::cout << "  pushed operators in the cut" << endl;
         while (!priority_queue.empty()) {
@@ -927,7 +945,7 @@ namespace numeric_lm_cut_heuristic {
                             relaxed_op->update_h_max_supporter();
                         ap_float new_supp_cost = relaxed_op->h_max_supporter_cost;
                         if (new_supp_cost != old_supp_cost) {
-                            if (debug) std::cout << "\t  " << prop->name <<" "<< relaxed_op->name << " " << new_supp_cost << " " << old_supp_cost << " " << prop_cost << endl;
+                            if (debug) std::cout << "\t  " << get_name(prop) <<" "<< get_name(relaxed_op) << " " << new_supp_cost << " " << old_supp_cost << " " << prop_cost << endl;
                             for (RelaxedProposition *effect : relaxed_op->effects)
                                 update_queue(state, relaxed_op->h_max_supporter, effect, relaxed_op);
                         }
@@ -949,7 +967,7 @@ namespace numeric_lm_cut_heuristic {
             if (numeric_task.is_numeric_axiom(init_fact.get_variable().get_id())) continue;
             RelaxedProposition *init_prop = get_proposition(init_fact);
             init_prop->status = BEFORE_GOAL_ZONE;
-            if (debug) std::cout << "\t\t  adding " << init_prop->name << " to the queue " << endl;
+            if (debug) std::cout << "\t\t  adding " << get_name(init_prop) << " to the queue " << endl;
             second_exploration_queue.push_back(init_prop);
         }
 
@@ -958,7 +976,7 @@ namespace numeric_lm_cut_heuristic {
                 if (numeric_initial_state[i] < precision) {
                     RelaxedProposition *init_prop = get_proposition(i);
                     init_prop->status = BEFORE_GOAL_ZONE;
-                    if (debug) std::cout << "\t\t  adding " << init_prop->name << " to the queue " << endl;
+                    if (debug) std::cout << "\t\t  adding " << get_name(init_prop) << " to the queue " << endl;
                     second_exploration_queue.push_back(init_prop);
                 }
             }
@@ -974,7 +992,7 @@ namespace numeric_lm_cut_heuristic {
             for (RelaxedOperator *relaxed_op : triggered_operators) {
                 ap_float min_cut_cost = std::numeric_limits<ap_float>::max();
 
-                if (relaxed_op->h_max_supporter == prop && std::find(cut.begin(), cut.end(), relaxed_op) == cut.end()) {
+                if (relaxed_op->h_max_supporter == prop && !relaxed_op->in_cut) {
                     for (RelaxedProposition *effect : relaxed_op->effects) {
                         if (effect->status == GOAL_ZONE) {
                             std::pair<ap_float, ap_float> ms = calculate_numeric_times(state, effect, relaxed_op, !disable_ma);
@@ -982,7 +1000,7 @@ namespace numeric_lm_cut_heuristic {
                             if ((relaxed_op->original_op_id_1 != -1 && ms.first >= precision)
                                 || (relaxed_op->original_op_id_1 == -1 && ms.second >= precision)) {
                                 if (debug) {
-                                    std::cout << "\t\t  adding " << relaxed_op->name << " to the cut with"; 
+                                    std::cout << "\t\t  adding " << get_name(relaxed_op) << " to the cut with"; 
 
                                     if (relaxed_op->original_op_id_1 != -1)
                                         std::cout << " cost1: " << relaxed_op->cost_1;
@@ -993,10 +1011,11 @@ namespace numeric_lm_cut_heuristic {
                                         std::cout << " m1: " << ms.first;
 
                                     std::cout << " m2: " << ms.second << std::endl;
-                                    std::cout << "\t\t" << prop->name << " -> " << effect->name << std::endl;
+                                    std::cout << "\t\t" << get_name(prop) << " -> " << get_name(effect) << std::endl;
                                 }
 
                                 cut.push_back(relaxed_op);
+                                relaxed_op->in_cut = true;
                                 m_list.push_back(ms);
 
                                 ap_float edge_cost = ms.second * relaxed_op->cost_2;
@@ -1018,7 +1037,7 @@ namespace numeric_lm_cut_heuristic {
 
                                 if (edge_cost < min_cut_cost) {
                                     effect->status = BEFORE_GOAL_ZONE;
-                                    if (debug) std::cout << "\t\t  adding " << effect->name << " to the queue " << endl;
+                                    if (debug) std::cout << "\t\t  adding " << get_name(effect) << " to the queue " << endl;
                                     second_exploration_queue.push_back(effect);
                                 }
                             }
@@ -1043,7 +1062,7 @@ namespace numeric_lm_cut_heuristic {
                     std::pair<ap_float, ap_float> ms = calculate_numeric_times(state, subgoal, achiever, !disable_ma);
 
                     if ((achiever->original_op_id_1 != -1 && ms.first >= precision) || ms.second >= precision) {
-                        if (debug) std::cout << "\tadding subgoal " <<  achiever->h_max_supporter->name << " from precondition of " << achiever->name << " which has effect " << subgoal->name << endl;
+                        if (debug) std::cout << "\tadding subgoal " <<  get_name(achiever->h_max_supporter) << " from precondition of " << get_name(achiever) << " which has effect " << get_name(subgoal) << endl;
                         mark_goal_plateau(state, achiever->h_max_supporter);
                     }
                 }
@@ -1131,21 +1150,23 @@ namespace numeric_lm_cut_heuristic {
                     if (m < precision) continue;
 
                     if (relaxed_op->original_op_id_1 == itr.first && relaxed_op->cost_1 >= precision) {
-                        if (debug) std::cout << "\tcut " << relaxed_op->name << " cost1: " << relaxed_op->cost_1;
+                        if (debug) std::cout << "\tcut " << get_name(relaxed_op) << " cost1: " << relaxed_op->cost_1;
                         m /= relaxed_op->cost_1;
                         relaxed_op->cost_1 -= cut_cost / m;
                         if (relaxed_op->cost_1 < precision) relaxed_op->cost_1 = 0;
                         if (debug) std::cout << " -> " << relaxed_op->cost_1<< " m1: " << m << endl;
                         operator_to_m[itr.first] = m;
+                        relaxed_op->cost_changed = true;
                     }
 
                     if (relaxed_op->original_op_id_2 == itr.first && relaxed_op->cost_2 >= precision) {
-                        if (debug) std::cout << "\tcut " << relaxed_op->name << " cost2: " << relaxed_op->cost_2;
+                        if (debug) std::cout << "\tcut " << get_name(relaxed_op) << " cost2: " << relaxed_op->cost_2;
                         m /= relaxed_op->cost_2;
                         relaxed_op->cost_2 -= cut_cost / m;
                         if (relaxed_op->cost_2 < precision) relaxed_op->cost_2 = 0;
                         if (debug) std::cout << " -> " << relaxed_op->cost_2 << " m2: " << m << endl;
                         operator_to_m[itr.first] = m;
+                        relaxed_op->cost_changed = true;
                     }
                 }
             }
@@ -1168,6 +1189,8 @@ namespace numeric_lm_cut_heuristic {
             
             first_exploration_incremental(state, cut);
             // validate_h_max();  // too expensive to use even in regular debug mode
+            for (RelaxedOperator *relaxed_op : cut)
+                relaxed_op->in_cut = false;
             cut.clear();
             m_list.clear();
             operator_to_m.clear();
@@ -1179,11 +1202,9 @@ namespace numeric_lm_cut_heuristic {
              or something based on total_cost, so that we don't need a per-round
              reinitialization.
              */
-            for (auto &var_props : propositions) {
-                for (RelaxedProposition &prop : var_props) {
-                    if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
-                        prop.status = REACHED;
-                }
+            for (RelaxedProposition &prop : propositions) {
+                if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
+                    prop.status = REACHED;
             }
             artificial_goal.status = REACHED;
             artificial_precondition.status = REACHED;
@@ -1201,17 +1222,17 @@ namespace numeric_lm_cut_heuristic {
                 if (relaxed_op->original_op_id_1 != -1 && ms.first >= precision) {
                     ap_float target_cost = prop->h_max_cost + ms.first * relaxed_op->cost_1 + ms.second * relaxed_op->cost_2;
                     bool queued = enqueue_if_necessary(effect, target_cost);
-                    if (debug && queued) std::cout << "\t  " << relaxed_op->h_max_supporter->name << " -> " << effect->name <<  " : " << relaxed_op->name << " " << target_cost << endl;
+                    if (debug && queued) std::cout << "\t  " << get_name(relaxed_op->h_max_supporter) << " -> " << get_name(effect) <<  " : " << get_name(relaxed_op) << " " << target_cost << endl;
                 } else if (relaxed_op->original_op_id_1 == -1 && ms.second >= precision) {
                     ap_float target_cost = prop->h_max_cost + ms.second * relaxed_op->cost_2;
                     bool queued = enqueue_if_necessary(effect, target_cost);
-                    if (debug && queued) std::cout << "\t  " << relaxed_op->h_max_supporter->name << " -> " << effect->name <<  " : " << relaxed_op->name << " " << target_cost << endl;
+                    if (debug && queued) std::cout << "\t  " << get_name(relaxed_op->h_max_supporter) << " -> " << get_name(effect) <<  " : " << get_name(relaxed_op) << " " << target_cost << endl;
                 }
             }
         } else {
             ap_float target_cost = prop->h_max_cost + relaxed_op->cost_2;
             bool queued = enqueue_if_necessary(effect, target_cost);
-            if(debug && queued) std::cout << "\t  " << relaxed_op->h_max_supporter->name << " -> " << effect->name <<  " : " << relaxed_op->name << " " << target_cost << endl;
+            if(debug && queued) std::cout << "\t  " << get_name(relaxed_op->h_max_supporter) << " -> " << get_name(effect) <<  " : " << get_name(relaxed_op) << " " << target_cost << endl;
         }
     }
     
@@ -25,66 +25,77 @@ namespace numeric_lm_cut_heuristic {
         BEFORE_GOAL_ZONE = 3
     };
     
+    /*
+      The members used in the explorations come first. Names are only
+      needed for debugging output and are stored in LandmarkCutLandmarks.
+    */
     struct RelaxedOperator {
-        int id;
-        int original_op_id_1;
-        int original_op_id_2;
         std::vector<RelaxedProposition *> preconditions;
         std::vector<RelaxedProposition *> effects;
-        std::vector<ap_float> sose_constants;
+        RelaxedProposition *h_max_supporter;
+        ap_float h_max_supporter_cost; // h_max_cost of h_max_supporter
+        ap_float cost_1;
+        ap_float cost_2;
+        int unsatisfied_preconditions;
+        int original_op_id_1;
+        int original_op_id_2;
         bool conditional;
         bool infinite;
-        
+        // Used to find the operators in the current cut and the operators
+        // whose cost changed without searching.
+        bool in_cut;
+        bool cost_changed;
+
         ap_float base_cost_1; // 0 for axioms, 1 for regular operators
         ap_float base_cost_2; // 0 for axioms, 1 for regular operators
-        
-        ap_float cost_1;
-        ap_float cost_2;
-        int unsatisfied_preconditions;
-        ap_float h_max_supporter_cost; // h_max_cost of h_max_supporter
-        RelaxedProposition *h_max_supporter;
-        
-        std::string name;
-        
+        std::vector<ap_float> sose_constants;
+        int name_id; // index into LandmarkCutLandmarks::operator_names
+
         RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
                         std::vector<RelaxedProposition *> &&eff,
-                        int op_id, ap_float base, std::string &n, bool conditional)
-        : original_op_id_1(-1),
-          original_op_id_2(op_id),
-          preconditions(pre),
+                        int op_id, ap_float base, int name_id, bool conditional)
+        : preconditions(pre),
           effects(eff),
+          original_op_id_1(-1),
+          original_op_id_2(op_id),
           conditional(conditional),
           infinite(false),
+          in_cut(false),
+          cost_changed(false),
           base_cost_1(0),
           base_cost_2(base),
-          name(n) {
+          name_id(name_id) {
         }
 
         RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
-                        int op_id, ap_float base, std::string &n, bool conditional, bool infinite)
-        : original_op_id_1(-1),
+                        int op_id, ap_float base, int name_id, bool conditional, bool infinite)
+        : preconditions(pre),
+          original_op_id_1(-1),
           original_op_id_2(op_id),
-          preconditions(pre),
           conditional(conditional),
           infinite(infinite),
+          in_cut(false),
+          cost_changed(false),
           base_cost_1(0),
           base_cost_2(base),
-          name(n) {
+          name_id(name_id) {
         }
 
         RelaxedOperator(std::vector<RelaxedProposition *> &&pre_1, const std::vector<RelaxedProposition *> &pre_2,
                         std::vector<RelaxedProposition *> &&eff, std::vector<ap_float> &&sose_constants,
-                        int op_id_1, int op_id_2, ap_float base_1, ap_float base_2, std::string &n_1, std::string& n_2)
-        : original_op_id_1(op_id_1),
-          original_op_id_2(op_id_2),
-          preconditions(pre_1),
+                        int op_id_1, int op_id_2, ap_float base_1, ap_float base_2, int name_id)
+        : preconditions(pre_1),
           effects(eff),
-          sose_constants(sose_constants),
+          original_op_id_1(op_id_1),
+          original_op_id_2(op_id_2),
           conditional(false),
           infinite(false),
+          in_cut(false),
+          cost_changed(false),
           base_cost_1(base_1),
           base_cost_2(base_2),
-          name(n_1 + " " + n_2) {
+          sose_constants(sose_constants),
+          name_id(name_id) {
           preconditions.insert(preconditions.end(), pre_2.begin(), pre_2.end());
         }
 
@@ -93,21 +104,29 @@ namespace numeric_lm_cut_heuristic {
     };
     
     struct RelaxedProposition {
-        std::vector<RelaxedOperator *> precondition_of;
-        std::vector<RelaxedOperator *> effect_of;
-        
+        ap_float h_max_cost;
         PropositionStatus status;
+        int id_numeric_condition;
         bool explored;
         bool is_numeric_condition;
-        int id_numeric_condition;
-        ap_float h_max_cost;
-        std::string name;
+        std::vector<RelaxedOperator *> precondition_of;
+        std::vector<RelaxedOperator *> effect_of;
     };
     
     class LandmarkCutLandmarks {
         numeric_helper::NumericTaskProxy numeric_task;
         std::vector<RelaxedOperator> relaxed_operators;
-        std::vector<std::vector<RelaxedProposition>> propositions;
+        /*
+          Propositions of all facts (ordered by variable and value) followed
+          by one proposition per numeric condition. All propositions are
+          created before the relaxed operators, which point to them.
+        */
+        std::vector<RelaxedProposition> propositions;
+        std::vector<int> variable_offsets;
+        int condition_offset;
+        // for debugging output only
+        std::vector<std::string> proposition_names;
+        std::vector<std::string> operator_names;
         std::vector<numeric_helper::LinearNumericCondition> conditions;
         std::vector<ap_float> epsilons;
         RelaxedProposition artificial_precondition;
@@ -157,8 +176,14 @@ namespace numeric_lm_cut_heuristic {
         void build_linear_operators(const TaskProxy &task_proxy, const OperatorProxy &op);
         void build_simple_effects();
         void delete_noops();
+        RelaxedProposition *get_proposition(int var, int value);
         RelaxedProposition *get_proposition(const FactProxy &fact);
         RelaxedProposition *get_proposition(const int &n_condition);
+        int add_operator_name(std::string &&name);
+        const std::string &get_name(const RelaxedProposition *prop) const;
+        const std::string &get_name(const RelaxedOperator *op) const {
+            return operator_names[op->name_id];
+        }
         void setup_exploration_queue();
         void setup_exploration_queue_state(const State &state);
         void first_exploration(const State &state);
@@ -180,6 +205,7 @@ namespace numeric_lm_cut_heuristic {
         }
         
         void update_queue(const State &state, RelaxedProposition *prec, RelaxedProposition *eff, RelaxedOperator *op);
+        void enqueue_changed_operator(const State &state, RelaxedOperator *relaxed_op);
         std::pair<ap_float, ap_float> calculate_numeric_times(const State &state, RelaxedProposition *effect, RelaxedOperator *relaxed_op, bool use_ma);
         ap_float calculate_constant_assignment_effect(const State &state, int op_id, const std::vector<ap_float> &coefficients, bool use_bounded_linear) const;
         ap_float calculate_linear_expression(const State &state, const std::vector<ap_float> &coefficients) const;
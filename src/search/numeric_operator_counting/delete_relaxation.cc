@@ -832,18 +832,8 @@ bool DeleteRelaxationConstraints::update_constraints(const State &state,
       }
       int fact_id = numeric_task.get_proposition(var, value);
 
-      if (lower_bound == 1) {
-        // if the upper bound is lower than the lower bound, OSI raises error
-        lp_solver.set_constraint_upper_bound(index_constraints[var][value],
-                                             lower_bound);
-        lp_solver.set_constraint_lower_bound(index_constraints[var][value],
-                                             lower_bound);
-      } else {
-        lp_solver.set_constraint_lower_bound(index_constraints[var][value],
-                                             lower_bound);
-        lp_solver.set_constraint_upper_bound(index_constraints[var][value],
-                                             lower_bound);
-      }
+      lp_solver.set_constraint_bounds(index_constraints[var][value],
+                                      lower_bound, lower_bound);
 
       if (landmark_constraints) {
         lp_solver.set_variable_lower_bound(indices_u_p[fact_id], 0);
@@ -39,14 +39,16 @@ void LMCutNumericConstraints::initialize_constraints(
 bool LMCutNumericConstraints::update_constraints(const State &state,
                                           lp::LPSolver &lp_solver) {
     assert(landmark_generator);
-    vector<lp::LPConstraint> constraints;
     double infinity = lp_solver.get_infinity();
+    size_t num_landmarks = 0;
 
     bool dead_end = landmark_generator->compute_landmarks(
         state, nullptr,
         [&](const vector<pair<double,int>> &op_ids, int /*cost*/) {
-            constraints.emplace_back(1.0, infinity);
-            lp::LPConstraint &landmark_constraint = constraints.back();
+            if (num_landmarks == landmark_constraints.size())
+                landmark_constraints.emplace_back(1.0, infinity);
+            lp::LPConstraint &landmark_constraint = landmark_constraints[num_landmarks++];
+            landmark_constraint.clear();
             for (pair<double,int> op_id : op_ids) {
                 //cout << op_id.second << " " << op_id.first << endl;
                 landmark_constraint.insert(op_id.second, 1./op_id.first);
@@ -58,7 +60,10 @@ bool LMCutNumericConstraints::update_constraints(const State &state,
     if (dead_end) {
         return true;
     } else {
-        lp_solver.add_temporary_constraints(constraints);
+        // Drop the constraints left over from states with more landmarks.
+        landmark_constraints.erase(landmark_constraints.begin() + num_landmarks,
+                                   landmark_constraints.end());
+        lp_solver.add_temporary_constraints(landmark_constraints);
         return false;
     }
 }
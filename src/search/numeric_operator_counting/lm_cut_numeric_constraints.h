@@ -4,7 +4,10 @@
 #include "../operator_counting/constraint_generator.h"
 #include "../numeric_landmarks/numeric_lm_cut_landmarks.h"
 
+#include "../lp/lp_solver.h"
+
 #include <memory>
+#include <vector>
 
 namespace lm_cut_numeric_heuristic {
 class LandmarkCutNumericLandmarks;
@@ -23,6 +26,8 @@ class LMCutNumericConstraints : public ConstraintGenerator {
     ap_float precision;
     ap_float epsilon;
     std::unique_ptr<numeric_lm_cut_heuristic::LandmarkCutLandmarks> landmark_generator;
+    // Reused in every state to avoid reallocating the constraints.
+    std::vector<lp::LPConstraint> landmark_constraints;
 public:
     LMCutNumericConstraints(const Options &opts);
     virtual void initialize_constraints(
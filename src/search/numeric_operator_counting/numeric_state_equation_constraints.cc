@@ -17,7 +17,7 @@ namespace operator_counting {
 
     void NumericStateEquationConstraints::add_numeric_goals_constraints(std::vector<lp::LPConstraint> &constraints, double infinity){
         for (size_t id_goal = 0; id_goal < numeric_task.get_n_numeric_goals(); ++id_goal) {
-            list<int> goals = numeric_task.get_numeric_goals(id_goal);
+            const list<int> &goals = numeric_task.get_numeric_goals(id_goal);
             if (goals.empty()) continue; // this is not a numeric goal
             for (int id_n_con : goals){
                 const LinearNumericCondition& lnc = numeric_task.get_condition(id_n_con);
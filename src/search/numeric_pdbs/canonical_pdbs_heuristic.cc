@@ -6,6 +6,8 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../pdbs/pdb_cache.h"
+
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -20,10 +22,29 @@ CanonicalPDBs get_canonical_pdbs_from_options(
     utils::Timer timer;
     PatternCollectionInformation pattern_collection_info =
         pattern_generator->generate(task);
+    shared_ptr<pdbs::PDBCache> cache = pdbs::create_pdb_cache_from_options(opts, *task);
+    pattern_collection_info.set_pdb_cache(cache);
     shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs();
     shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets =
         pattern_collection_info.get_max_additive_subsets();
     cout << "PDB collection construction time: " << timer << endl;
+    if (cache)
+        cache->print_statistics();
+
+    size_t memory = 0;
+    size_t memory_before_perfect_hashing = 0;
+    int num_perfect_hashing_pdbs = 0;
+    for (const shared_ptr<PatternDatabase> &pdb : *pdbs) {
+        memory += pdb->estimate_memory_usage();
+        memory_before_perfect_hashing += pdb->get_memory_usage_before_perfect_hashing();
+        if (pdb->uses_perfect_hashing()) {
+            ++num_perfect_hashing_pdbs;
+        }
+    }
+    cout << "PDBs with perfect hashing: " << num_perfect_hashing_pdbs
+         << "/" << pdbs->size() << endl;
+    cout << "PDB collection memory: " << memory << " bytes ("
+         << memory_before_perfect_hashing << " bytes before perfect hashing)" << endl;
 
     bool dominance_pruning = opts.get<bool>("dominance_pruning");
     return {pdbs, max_additive_subsets, dominance_pruning};
@@ -35,6 +56,7 @@ CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(const Options &opts)
 }
 
 void CanonicalPDBsHeuristic::print_statistics() const {
+    Heuristic::print_statistics();
     cout << "Number of failed heuristic lookups: " << canonical_pdbs.get_number_lookup_misses() << endl;
 }
 
@@ -79,6 +101,7 @@ static Heuristic *_parse(OptionParser &parser) {
         "the heuristic value because there are dominating patterns in the "
         "collection.",
         "true");
+    pdbs::add_pdb_cache_options_to_parser(parser);
 
     Heuristic::add_options_to_parser(parser);
 
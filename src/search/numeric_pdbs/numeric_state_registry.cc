@@ -50,4 +50,14 @@ size_t NumericStateRegistry::get_id(const NumericState &state) {
     assert(registered_states.size() == state_data_pool.size());
     return *result.first;
 }
-}
\ No newline at end of file
+
+size_t NumericStateRegistry::estimate_memory_usage() const {
+    size_t num_values = state_data_pool.size() == 0 ? 0 : state_data_pool[0].num_state.size();
+    size_t state_size = sizeof(NumericState) + num_values * sizeof(ap_float);
+    // nodes of the hash set store the ID and a pointer to the next node
+    size_t node_size = sizeof(size_t) + sizeof(void *);
+    return state_data_pool.size() * state_size +
+           registered_states.size() * node_size +
+           registered_states.bucket_count() * sizeof(void *);
+}
+}
@@ -90,6 +90,9 @@ public:
     std::size_t size() const {
         return state_data_pool.size();
     }
+
+    // Rough estimate of the memory used by the states and the hash set
+    std::size_t estimate_memory_usage() const;
 };
 }
 #endif
\ No newline at end of file
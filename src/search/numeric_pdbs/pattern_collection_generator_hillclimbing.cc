@@ -21,10 +21,14 @@
 #include "../utils/timer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <exception>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <thread>
+#include <unordered_map>
 
 using namespace std;
 using namespace numeric_pdb_helper;
@@ -39,6 +43,7 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(c
       min_improvement(opts.get<int>("min_improvement")),
       max_time(opts.get<double>("max_time")),
       max_pdb_size(opts.get<int>("max_pdb_size")),
+      num_threads(opts.get<int>("threads")),
       num_rejected(0),
       hill_climbing_timer(nullptr) {
 }
@@ -149,24 +154,61 @@ void PatternCollectionGeneratorHillclimbing::generate_candidate_patterns(
     }
 }
 
+/*
+  Calls process(worker_id, task) for all tasks 0..num_tasks-1, distributed
+  dynamically over num_threads threads. With one thread, the tasks are
+  processed in order in the calling thread.
+*/
+static void run_in_parallel(int num_threads, size_t num_tasks,
+                            const function<void(int, size_t)> &process) {
+    if (num_threads == 1 || num_tasks <= 1) {
+        for (size_t task = 0; task < num_tasks; ++task) {
+            process(0, task);
+        }
+        return;
+    }
+    atomic<size_t> next_task(0);
+    auto run_worker = [&](int worker_id) {
+        for (size_t task = next_task++; task < num_tasks; task = next_task++) {
+            process(worker_id, task);
+        }
+    };
+    vector<thread> threads;
+    int num_workers = min<size_t>(num_threads, num_tasks);
+    for (int i = 0; i < num_workers; ++i)
+        threads.emplace_back(run_worker, i);
+    for (thread &t : threads)
+        t.join();
+}
+
 size_t PatternCollectionGeneratorHillclimbing::generate_pdbs_for_candidates(
-    const shared_ptr<NumericTaskProxy> &task_proxy, set<Pattern> &generated_patterns,
-    PatternCollection &new_candidates, PDBCollection &candidate_pdbs) const {
+    set<Pattern> &generated_patterns, PatternCollection &new_candidates,
+    PDBCollection &candidate_pdbs) const {
     /*
       For the new candidate patterns check whether they already have been
       candidates before and thus already a PDB has been created an inserted into
       candidate_pdbs.
     */
-    size_t max_pdb_size = 0;
+    PatternCollection patterns_to_build;
     for (const Pattern &new_candidate : new_candidates) {
-        if (generated_patterns.count(new_candidate) == 0) {
-            candidate_pdbs.push_back(
-                make_shared<PatternDatabase>(task_proxy, new_candidate, max_number_pdb_states));
-            max_pdb_size = max(max_pdb_size,
-                               candidate_pdbs.back()->get_size());
-            generated_patterns.insert(new_candidate);
+        if (generated_patterns.insert(new_candidate).second) {
+            patterns_to_build.push_back(new_candidate);
         }
     }
+
+    PDBCollection new_pdbs(patterns_to_build.size());
+    run_in_parallel(num_threads, patterns_to_build.size(),
+                    [&](int worker_id, size_t i) {
+                        new_pdbs[i] = make_shared<PatternDatabase>(
+                            worker_task_proxies[worker_id], patterns_to_build[i],
+                            max_number_pdb_states);
+                    });
+
+    size_t max_pdb_size = 0;
+    for (const shared_ptr<PatternDatabase> &pdb : new_pdbs) {
+        max_pdb_size = max(max_pdb_size, pdb->get_size());
+        candidate_pdbs.push_back(pdb);
+    }
     return max_pdb_size;
 }
 
@@ -201,7 +243,7 @@ std::pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_
     int improvement = 0;
     int best_pdb_index = -1;
 
-    // Iterate over all candidates and search for the best improving pattern/pdb
+    vector<size_t> candidates;
     for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
         if (hill_climbing_timer->is_expired())
             throw HillClimbingTimeout();
@@ -221,7 +263,38 @@ std::pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_
             candidate_pdbs[i] = nullptr;
             continue;
         }
+        candidates.push_back(i);
+    }
 
+    /*
+      Looking up a state in a PDB is not thread-safe, so we compute the
+      h-values of the current collection and its PDBs for all samples
+      before the candidates are evaluated in parallel.
+    */
+    const PDBCollection &current_pdb_collection = *current_pdbs->get_pattern_databases();
+    unordered_map<const PatternDatabase *, int> current_pdb_index;
+    for (size_t i = 0; i < current_pdb_collection.size(); ++i) {
+        current_pdb_index[current_pdb_collection[i].get()] = i;
+    }
+    vector<ap_float> h_collection(samples.size());
+    vector<vector<ap_float>> pdb_values(samples.size());
+    for (size_t j = 0; j < samples.size(); ++j) {
+        h_collection[j] = current_pdbs->get_value(samples[j]);
+        pdb_values[j].reserve(current_pdb_collection.size());
+        for (const shared_ptr<PatternDatabase> &pdb : current_pdb_collection) {
+            pdb_values[j].push_back(pdb->get_value(samples[j]).second);
+        }
+    }
+
+    vector<int> counts(candidates.size(), 0);
+    atomic<bool> timeout(false);
+    run_in_parallel(num_threads, candidates.size(),
+                    [&](int, size_t k) {
+        if (timeout || hill_climbing_timer->is_expired()) {
+            timeout = true;
+            return;
+        }
+        const PatternDatabase &pdb = *candidate_pdbs[candidates[k]];
         /*
           Calculate the "counting approximation" for all sample states: count
           the number of samples for which the current pattern collection
@@ -232,13 +305,31 @@ std::pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_
           statistical confidence interval to stop the A*-search (which they use,
           see above) earlier.
         */
-        int count = 0;
         MaxAdditivePDBSubsets max_additive_subsets =
-            current_pdbs->get_max_additive_subsets(pdb->get_pattern());
-        for (const State &sample : samples) {
-            if (is_heuristic_improved(*pdb, sample, max_additive_subsets))
+            current_pdbs->get_max_additive_subsets(pdb.get_pattern());
+        vector<vector<int>> subsets;
+        subsets.reserve(max_additive_subsets.size());
+        for (const PDBCollection &subset : max_additive_subsets) {
+            subsets.emplace_back();
+            for (const shared_ptr<PatternDatabase> &additive_pdb : subset) {
+                subsets.back().push_back(current_pdb_index.at(additive_pdb.get()));
+            }
+        }
+        int count = 0;
+        for (size_t j = 0; j < samples.size(); ++j) {
+            if (is_heuristic_improved(pdb, samples[j], h_collection[j],
+                                      pdb_values[j], subsets))
                 ++count;
         }
+        counts[k] = count;
+    });
+    if (timeout)
+        throw HillClimbingTimeout();
+
+    // Iterate over all candidates and search for the best improving pattern/pdb
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        size_t i = candidates[k];
+        int count = counts[k];
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
@@ -254,8 +345,9 @@ std::pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_
 }
 
 bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
-    const PatternDatabase &pdb, const State &sample,
-    const MaxAdditivePDBSubsets &max_additive_subsets) {
+    const PatternDatabase &pdb, const State &sample, ap_float h_collection,
+    const vector<ap_float> &pdb_values,
+    const vector<vector<int>> &max_additive_subsets) const {
     // h_pattern: h-value of the new pattern
     ap_float h_pattern = pdb.get_value(sample).second;
 
@@ -264,17 +356,14 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
     }
 
     // h_collection: h-value of the current collection heuristic
-    ap_float h_collection = current_pdbs->get_value(sample);
     if (h_collection == numeric_limits<ap_float>::max()){
         return false;
     }
 
     for (const auto &subset : max_additive_subsets) {
         ap_float h_subset = 0;
-        for (const shared_ptr<PatternDatabase> &additive_pdb : subset) {
-            /* Experiments showed that it is faster to recompute the
-               h values than to cache them in an unordered_map. */
-            ap_float h = additive_pdb->get_value(sample).second;
+        for (int additive_pdb : subset) {
+            ap_float h = pdb_values[additive_pdb];
             if (h == numeric_limits<ap_float>::max()) {
                 return false;
             }
@@ -322,7 +411,7 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
             }
 
             size_t new_max_pdb_size = generate_pdbs_for_candidates(
-                    task_proxy, generated_patterns, new_candidates, candidate_pdbs);
+                    generated_patterns, new_candidates, candidate_pdbs);
             max_pdb_size = max(max_pdb_size, new_max_pdb_size);
 
             vector<State> samples;
@@ -401,6 +490,11 @@ PatternCollectionInformation PatternCollectionGeneratorHillclimbing::generate(sh
         initial_pattern_collection.push_back(goal_pattern);
     }
 
+    worker_task_proxies.assign(1, num_task_proxy);
+    for (int i = 1; i < num_threads; ++i) {
+        worker_task_proxies.push_back(make_shared<NumericTaskProxy>(task));
+    }
+
     current_pdbs = utils::make_unique_ptr<IncrementalCanonicalPDBs>(
         task, num_task_proxy, initial_pattern_collection, max_number_pdb_states);
 
@@ -469,6 +563,12 @@ void add_hillclimbing_options(OptionParser &parser) {
             "is performed at all.",
             "infinity",
             Bounds("0.0", "infinity"));
+    parser.add_option<int>(
+            "threads",
+            "number of threads used to build the candidate pattern databases "
+            "and to evaluate them on the samples",
+            "1",
+            Bounds("1", "infinity"));
 }
 
 void check_hillclimbing_options(
@@ -624,6 +724,8 @@ static Heuristic *_parse_ipdb(OptionParser &parser) {
             "redundant_constraints", true);
     heuristic_opts.set<bool>( // TODO this is somewhat of a hack
             "rounding_up", false);
+    heuristic_opts.set<int>(
+        "projection_cache_memory", 0);
 
     // Note: in the long run, this should return a shared pointer.
     return new CanonicalPDBsHeuristic(heuristic_opts);
@@ -40,6 +40,14 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
 
     const int max_pdb_size;
 
+    /*
+      Number of threads used to build the candidate PDBs and to evaluate
+      them on the samples. Each thread has its own task proxy, which is
+      used for the PDBs it builds.
+    */
+    const int num_threads;
+    std::vector<std::shared_ptr<numeric_pdb_helper::NumericTaskProxy>> worker_task_proxies;
+
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
 
     // for stats only
@@ -58,10 +66,10 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
 
     /*
       Generates the PatternDatabase for patterns in new_candidates if they have
-      not been generated already.
+      not been generated already. The PDBs are built in parallel and appended
+      to candidate_pdbs in the order of new_candidates.
     */
     std::size_t generate_pdbs_for_candidates(
-            const std::shared_ptr<numeric_pdb_helper::NumericTaskProxy> &num_task_proxy,
             std::set<Pattern> &generated_patterns,
             PatternCollection &new_candidates,
             PDBCollection &candidate_pdbs) const;
@@ -85,7 +93,8 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     /*
       Searches for the best improving pdb in candidate_pdbs according to the
       counting approximation and the given samples. Returns the improvement and
-      the index of the best pdb in candidate_pdbs.
+      the index of the best pdb in candidate_pdbs. The candidates are
+      evaluated in parallel, ties are broken in favor of the smallest index.
     */
     std::pair<int, int> find_best_improving_pdb(
         std::vector<State> &samples,
@@ -95,12 +104,17 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       Returns true iff the h-value of the new pattern (from pdb) plus the
       h-value of all maximal additive subsets from the current pattern
       collection heuristic if the new pattern was added to it is greater than
-      the h-value of the current pattern collection.
+      the h-value of the current pattern collection. The h-values of the
+      current collection and its PDBs on the sample are precomputed and
+      passed as h_collection and pdb_values; max_additive_subsets contains
+      indices into pdb_values.
     */
     bool is_heuristic_improved(
         const PatternDatabase &pdb,
         const State &sample,
-        const MaxAdditivePDBSubsets &max_additive_subsets);
+        ap_float h_collection,
+        const std::vector<ap_float> &pdb_values,
+        const std::vector<std::vector<int>> &max_additive_subsets) const;
 
     /*
       This is the core algorithm of this class. As soon as after an iteration,
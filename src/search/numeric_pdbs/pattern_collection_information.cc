@@ -4,6 +4,8 @@
 #include "pattern_database.h"
 #include "validation.h"
 
+#include "../pdbs/pdb_cache.h"
+
 #include <algorithm>
 #include <cassert>
 #include <unordered_set>
@@ -20,7 +22,8 @@ PatternCollectionInformation::PatternCollectionInformation(
           patterns(patterns),
           pdbs(nullptr),
           max_additive_subsets(nullptr),
-          max_number_pdb_states(max_number_pdb_states) {
+          max_number_pdb_states(max_number_pdb_states),
+          pdb_cache(nullptr) {
     assert(patterns);
     validate_and_normalize_patterns(*task_proxy, *patterns);
 }
@@ -75,7 +78,8 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
         pdbs = make_shared<PDBCollection>();
         for (const Pattern &pattern : *patterns) {
             shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern, max_number_pdb_states);
+                make_shared<PatternDatabase>(task_proxy, pattern, max_number_pdb_states,
+                                             false, vector<ap_float>(), pdb_cache);
             pdbs->push_back(pdb);
         }
     }
@@ -101,6 +105,10 @@ void PatternCollectionInformation::set_max_additive_subsets(
     assert(information_is_valid());
 }
 
+void PatternCollectionInformation::set_pdb_cache(shared_ptr<pdbs::PDBCache> pdb_cache_) {
+    pdb_cache = pdb_cache_;
+}
+
 shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() {
     assert(patterns);
     return patterns;
@@ -6,6 +6,10 @@
 
 #include <memory>
 
+namespace pdbs {
+class PDBCache;
+}
+
 namespace numeric_pdbs {
 /*
   This class contains everything we know about a pattern collection. It will
@@ -25,6 +29,8 @@ class PatternCollectionInformation {
     // approximate upper bound on the number of abstract states per PDB possibly reachable within the pattern
     size_t max_number_pdb_states;
 
+    std::shared_ptr<pdbs::PDBCache> pdb_cache;
+
     void create_pdbs_if_missing();
     void create_max_additive_subsets_if_missing();
 
@@ -39,6 +45,8 @@ public:
     void set_pdbs(std::shared_ptr<PDBCollection> pdbs);
     void set_max_additive_subsets(
         std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets);
+    // Missing PDBs are loaded from and written to this cache.
+    void set_pdb_cache(std::shared_ptr<pdbs::PDBCache> pdb_cache);
 
     std::shared_ptr<PatternCollection> get_patterns();
     std::shared_ptr<PDBCollection> get_pdbs();
@@ -7,7 +7,9 @@
 
 #include "../priority_queue.h"
 
+#include "../pdbs/pdb_cache.h"
 #include "../utils/logging.h"
+#include "../utils/mapped_file.h"
 #include "../utils/math.h"
 
 #include <algorithm>
@@ -93,9 +95,18 @@ PatternDatabase::PatternDatabase(
         const Pattern &pattern,
         size_t max_number_states,
         bool dump,
-        const vector<ap_float> &operator_costs)
+        const vector<ap_float> &operator_costs,
+        const shared_ptr<pdbs::PDBCache> &cache)
         : task_proxy(task_proxy),
           pattern(pattern),
+          num_prop_states(1),
+          use_perfect_hashing(false),
+          cached_distances(nullptr),
+          cached_perfect_hash_keys(nullptr),
+          num_distances(0),
+          num_perfect_hash_keys(0),
+          num_abstract_states(0),
+          memory_before_perfect_hashing(0),
           min_action_cost(numeric_limits<ap_float>::max()),
           exhausted_abstract_state_space(false) {
 
@@ -120,15 +131,166 @@ PatternDatabase::PatternDatabase(
         }
     }
 
+    num_prop_states = domain_size_product;
+
+    if (cache && load_from_cache(*cache, max_number_states, operator_costs)) {
+        if (dump)
+            cout << "PDB loaded from cache: " << timer << endl;
+        return;
+    }
     if (pattern.numeric.empty()){
         create_pdb_propositional(domain_size_product, operator_costs);
+        num_distances = distances.size();
+        num_abstract_states = distances.size();
+        memory_before_perfect_hashing = estimate_memory_usage();
     } else {
         create_pdb(max_number_states, operator_costs, dump);
     }
+    if (cache)
+        save_to_cache(*cache, max_number_states, operator_costs);
     if (dump)
         cout << "PDB construction time: " << timer << endl;
 }
 
+static pdbs::PDBFileWriter get_cache_key(const Pattern &pattern,
+                                         size_t max_number_states,
+                                         const vector<ap_float> &operator_costs) {
+    pdbs::PDBFileWriter key;
+    key.write_vector(pattern.regular);
+    key.write_vector(pattern.numeric);
+    // The state limit only matters if there are numeric variables.
+    key.write<uint64_t>(pattern.numeric.empty() ? 0 : max_number_states);
+    key.write_vector(operator_costs);
+    return key;
+}
+
+/*
+  Propositional PDBs and PDBs with perfect hashing are used in place in
+  the mapped file. For the other PDBs, the state registry is rebuilt from
+  the stored abstract states.
+*/
+bool PatternDatabase::load_from_cache(const pdbs::PDBCache &cache,
+                                      size_t max_number_states,
+                                      const vector<ap_float> &operator_costs) {
+    pdbs::PDBFileReader reader;
+    if (!cache.load(pdbs::PDBType::NUMERIC,
+                    get_cache_key(pattern, max_number_states, operator_costs),
+                    reader)) {
+        return false;
+    }
+    bool exhausted = reader.read<uint32_t>();
+    bool perfect_hashing = reader.read<uint32_t>();
+    ap_float action_cost = reader.read<ap_float>();
+    size_t num_states = reader.read<uint64_t>();
+    size_t memory_before = reader.read<uint64_t>();
+
+    size_t num_values;
+    const ap_float *values;
+    size_t num_keys = 0;
+    const size_t *keys = nullptr;
+    vector<size_t> multipliers;
+    vector<vector<ap_float>> reached_values;
+    unique_ptr<NumericStateRegistry> registry;
+    if (pattern.numeric.empty() || perfect_hashing) {
+        if (perfect_hashing) {
+            multipliers = reader.read_vector<size_t>();
+            reached_values.resize(pattern.numeric.size());
+            for (vector<ap_float> &var_values : reached_values)
+                var_values = reader.read_vector<ap_float>();
+            keys = reader.read_array<size_t>(num_keys);
+        }
+        values = reader.read_array<ap_float>(num_values);
+    } else {
+        size_t num_prop_hashes;
+        const size_t *prop_hashes = reader.read_array<size_t>(num_prop_hashes);
+        size_t num_numeric_values;
+        const ap_float *numeric_values = reader.read_array<ap_float>(num_numeric_values);
+        values = reader.read_array<ap_float>(num_values);
+        if (!reader.is_valid() || num_prop_hashes != num_values ||
+            num_numeric_values != num_values * pattern.numeric.size()) {
+            return false;
+        }
+        registry = make_unique<NumericStateRegistry>();
+        for (size_t i = 0; i < num_values; ++i) {
+            const ap_float *num_state = numeric_values + i * pattern.numeric.size();
+            registry->insert_state(NumericState(
+                prop_hashes[i], vector<ap_float>(num_state, num_state + pattern.numeric.size())));
+        }
+    }
+    if (!reader.is_valid() ||
+        (pattern.numeric.empty() && num_values != num_prop_states) ||
+        (perfect_hashing && multipliers.size() != pattern.numeric.size())) {
+        return false;
+    }
+
+    exhausted_abstract_state_space = exhausted;
+    use_perfect_hashing = perfect_hashing;
+    min_action_cost = action_cost;
+    num_abstract_states = num_states;
+    memory_before_perfect_hashing = memory_before;
+    num_distances = num_values;
+    if (registry) {
+        state_registry = move(registry);
+        distances.assign(values, values + num_values);
+    } else {
+        cache_file = reader.get_file();
+        cached_distances = values;
+        cached_perfect_hash_keys = keys;
+        num_perfect_hash_keys = num_keys;
+        num_hash_multipliers.swap(multipliers);
+        reached_numeric_values.swap(reached_values);
+    }
+
+    vector<int> variable_to_index(task_proxy->get_variables().size(), -1);
+    for (size_t i = 0; i < pattern.regular.size(); ++i) {
+        variable_to_index[pattern.regular[i]] = i;
+    }
+    vector<int> num_variable_to_index(task_proxy->get_numeric_variables().size(), -1);
+    for (size_t i = 0; i < pattern.numeric.size(); ++i) {
+        num_variable_to_index[pattern.numeric[i]] = i;
+    }
+    build_goals(variable_to_index, num_variable_to_index);
+    return true;
+}
+
+void PatternDatabase::save_to_cache(const pdbs::PDBCache &cache,
+                                    size_t max_number_states,
+                                    const vector<ap_float> &operator_costs) const {
+    if (!cache.is_writing_enabled())
+        return;
+    pdbs::PDBFileWriter content;
+    content.write<uint32_t>(exhausted_abstract_state_space);
+    content.write<uint32_t>(use_perfect_hashing);
+    content.write(min_action_cost);
+    content.write<uint64_t>(num_abstract_states);
+    content.write<uint64_t>(memory_before_perfect_hashing);
+    if (pattern.numeric.empty() || use_perfect_hashing) {
+        if (use_perfect_hashing) {
+            content.write_vector(num_hash_multipliers);
+            for (const vector<ap_float> &var_values : reached_numeric_values)
+                content.write_vector(var_values);
+            content.write_vector(perfect_hash_keys);
+        }
+    } else {
+        vector<size_t> prop_hashes;
+        vector<ap_float> numeric_values;
+        prop_hashes.reserve(distances.size());
+        numeric_values.reserve(distances.size() * pattern.numeric.size());
+        for (size_t state_id = 0; state_id < distances.size(); ++state_id) {
+            const NumericState &state = state_registry->lookup_state(state_id);
+            prop_hashes.push_back(state.prop_hash);
+            numeric_values.insert(numeric_values.end(),
+                                  state.num_state.begin(), state.num_state.end());
+        }
+        content.write_vector(prop_hashes);
+        content.write_vector(numeric_values);
+    }
+    content.write_vector(distances);
+    cache.save(pdbs::PDBType::NUMERIC,
+               get_cache_key(pattern, max_number_states, operator_costs),
+               content);
+}
+
 void PatternDatabase::multiply_out(
     int pos, int op_id, ap_float cost,
     vector<pair<int, int>> &prev_pairs,
@@ -286,9 +448,6 @@ void PatternDatabase::create_pdb(size_t max_number_states,
     //  as there are finitely many abstract goal states.
     //     => this is not worth it with the current benchmarks; no domain falls into this special case
 
-    // TODO: if we manage to exhaust the state space, it is probably more efficient to do perfect hashing, where we map
-    //  the reached values of numeric variables to indices 0..N-1
-
     // TODO: we could try perfect hashing in all cases, where we sort reached numeric values such that the PDB vector
     //  is as dense as possible, and only having it just large enough to fit the abstract state with highest ID that has
     //  a finite heuristic value, with all others being deadends or mapped to min_action_cost by convention.
@@ -585,11 +744,97 @@ void PatternDatabase::create_pdb(size_t max_number_states,
         state_registry.reset(tmp_state_registry);
     }
 
+    num_abstract_states = distances.size();
+    num_distances = distances.size();
+    memory_before_perfect_hashing = estimate_memory_usage();
+    if (exhausted_abstract_state_space) {
+        build_perfect_hash_table();
+    }
     if (dump) {
+        cout << "PDB memory: " << estimate_memory_usage() << " bytes ("
+             << memory_before_perfect_hashing << " bytes before perfect hashing)" << endl;
         cout << "Initial state h: " << get_value(task_proxy->get_original_initial_state()) << endl;
     }
 }
 
+void PatternDatabase::build_perfect_hash_table() {
+    assert(exhausted_abstract_state_space && !use_perfect_hashing);
+    size_t num_numeric_vars = pattern.numeric.size();
+    vector<vector<ap_float>> values(num_numeric_vars);
+    size_t num_finite_states = 0;
+    for (size_t state_id = 0; state_id < distances.size(); ++state_id) {
+        if (distances[state_id] == numeric_limits<ap_float>::max()) {
+            // states that are not in the table are dead ends
+            continue;
+        }
+        ++num_finite_states;
+        const NumericState &state = state_registry->lookup_state(state_id);
+        for (size_t i = 0; i < num_numeric_vars; ++i) {
+            values[i].push_back(state.num_state[i]);
+        }
+    }
+
+    size_t table_size = num_prop_states;
+    vector<size_t> multipliers;
+    multipliers.reserve(num_numeric_vars);
+    for (vector<ap_float> &var_values : values) {
+        sort(var_values.begin(), var_values.end());
+        var_values.erase(unique(var_values.begin(), var_values.end()), var_values.end());
+        var_values.shrink_to_fit();
+        multipliers.push_back(table_size);
+        if (!var_values.empty() &&
+            table_size > numeric_limits<size_t>::max() / var_values.size()) {
+            // the hash values do not fit into size_t, keep the state registry
+            return;
+        }
+        table_size *= var_values.size();
+    }
+
+    vector<pair<size_t, ap_float>> entries;
+    entries.reserve(num_finite_states);
+    for (size_t state_id = 0; state_id < distances.size(); ++state_id) {
+        if (distances[state_id] == numeric_limits<ap_float>::max()) {
+            continue;
+        }
+        const NumericState &state = state_registry->lookup_state(state_id);
+        size_t index = state.prop_hash;
+        for (size_t i = 0; i < num_numeric_vars; ++i) {
+            const vector<ap_float> &var_values = values[i];
+            auto it = lower_bound(var_values.begin(), var_values.end(), state.num_state[i]);
+            assert(it != var_values.end() && *it == state.num_state[i]);
+            index += multipliers[i] * (it - var_values.begin());
+        }
+        entries.emplace_back(index, distances[state_id]);
+    }
+
+    vector<ap_float> table;
+    vector<size_t> keys;
+    if (table_size <= 2 * num_finite_states) {
+        // dense enough for a table with one entry per hash value
+        table.resize(table_size, numeric_limits<ap_float>::max());
+        for (const auto &[index, distance] : entries) {
+            table[index] = distance;
+        }
+    } else {
+        sort(entries.begin(), entries.end());
+        keys.reserve(entries.size());
+        table.reserve(entries.size());
+        for (const auto &[index, distance] : entries) {
+            keys.push_back(index);
+            table.push_back(distance);
+        }
+    }
+
+    distances.swap(table);
+    perfect_hash_keys.swap(keys);
+    num_distances = distances.size();
+    num_perfect_hash_keys = perfect_hash_keys.size();
+    reached_numeric_values.swap(values);
+    num_hash_multipliers.swap(multipliers);
+    state_registry.reset();
+    use_perfect_hashing = true;
+}
+
 void PatternDatabase::create_pdb_propositional(size_t size,
                                                const std::vector<ap_float> &operator_costs) {
 
@@ -719,7 +964,30 @@ const vector<ap_float> &PatternDatabase::get_abstract_numeric_state(const State
 pair<bool, ap_float> PatternDatabase::get_value(const State &state) const {
     if (pattern.numeric.empty()){
         // purely propositional pattern
-        return {true, distances[prop_hash_index(state)]};
+        return {true, get_distances()[prop_hash_index(state)]};
+    }
+    if (use_perfect_hashing) {
+        size_t index = prop_hash_index(state);
+        for (size_t i = 0; i < pattern.numeric.size(); ++i) {
+            ap_float val = task_proxy->get_numeric_state_value(state, pattern.numeric[i]);
+            const vector<ap_float> &values = reached_numeric_values[i];
+            auto it = lower_bound(values.begin(), values.end(), val);
+            if (it == values.end() || *it != val) {
+                // the abstract state space is exhausted, so state is a deadend
+                return {true, numeric_limits<ap_float>::max()};
+            }
+            index += num_hash_multipliers[i] * (it - values.begin());
+        }
+        if (num_perfect_hash_keys > 0) {
+            const size_t *keys_begin = get_perfect_hash_keys();
+            const size_t *keys_end = keys_begin + num_perfect_hash_keys;
+            const size_t *it = lower_bound(keys_begin, keys_end, index);
+            if (it == keys_end || *it != index) {
+                return {true, numeric_limits<ap_float>::max()};
+            }
+            index = it - keys_begin;
+        }
+        return {true, get_distances()[index]};
     }
     size_t abs_state_id = state_registry->get_id(NumericState(prop_hash_index(state),
                                                                get_abstract_numeric_state(state)));
@@ -739,6 +1007,25 @@ pair<bool, ap_float> PatternDatabase::get_value(const State &state) const {
     return {true, distances[abs_state_id]};
 }
 
+size_t PatternDatabase::estimate_memory_usage() const {
+    size_t memory = distances.capacity() * sizeof(ap_float);
+    if (cached_distances) {
+        memory += num_distances * sizeof(ap_float);
+    }
+    if (cached_perfect_hash_keys) {
+        memory += num_perfect_hash_keys * sizeof(size_t);
+    }
+    if (state_registry) {
+        memory += state_registry->estimate_memory_usage();
+    }
+    for (const vector<ap_float> &values : reached_numeric_values) {
+        memory += values.capacity() * sizeof(ap_float);
+    }
+    memory += num_hash_multipliers.capacity() * sizeof(size_t);
+    memory += perfect_hash_keys.capacity() * sizeof(size_t);
+    return memory;
+}
+
 ap_float PatternDatabase::compute_mean_finite_h() const {
     cerr << "Not yet implemented: numeric PatternDatabase::compute_mean_finite_h()" << endl;
     utils::exit_with(utils::ExitCode::CRITICAL_ERROR);
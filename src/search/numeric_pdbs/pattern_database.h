@@ -7,10 +7,19 @@
 
 #include "../task_proxy.h" // TODO get rid of this
 
+#include <memory>
 #include <utility>
 #include <vector>
 
 
+namespace pdbs {
+class PDBCache;
+}
+
+namespace utils {
+class MappedFile;
+}
+
 namespace numeric_pdb_helper {
 class NumericOperatorProxy;
 class NumericTaskProxy;
@@ -100,6 +109,42 @@ class PatternDatabase {
     // multipliers for each propositional variable for perfect hash function
     std::vector<std::size_t> prop_hash_multipliers;
 
+    // product of the domain sizes of the propositional pattern variables
+    std::size_t num_prop_states;
+
+    /*
+      If the abstract state space is exhausted, the state registry is
+      replaced by a perfect hash function (see build_perfect_hash_table).
+      The reached values of each numeric pattern variable (sorted) are
+      mapped to their position, and the hash value of an abstract state is
+      its propositional hash plus the sum of the positions of its numeric
+      values times their multipliers. If most hash values belong to dead
+      ends, the hash values of the other states are stored in
+      perfect_hash_keys (sorted) and distances is indexed by the position
+      of the key. Otherwise, perfect_hash_keys is empty and distances is
+      indexed by the hash value.
+    */
+    bool use_perfect_hashing;
+    std::vector<std::vector<ap_float>> reached_numeric_values;
+    std::vector<std::size_t> num_hash_multipliers;
+    std::vector<std::size_t> perfect_hash_keys;
+
+    /*
+      If the PDB is loaded from the PDB cache, distances and
+      perfect_hash_keys of perfect hashing PDBs stay empty and the tables
+      are read from the mapped cache file instead.
+    */
+    std::shared_ptr<utils::MappedFile> cache_file;
+    const ap_float *cached_distances;
+    const std::size_t *cached_perfect_hash_keys;
+    std::size_t num_distances;
+    std::size_t num_perfect_hash_keys;
+
+    // number of abstract states stored before perfect hashing (see get_size)
+    std::size_t num_abstract_states;
+    // for statistics only
+    std::size_t memory_before_perfect_hashing;
+
     std::vector<std::pair<int, int>> propositional_goals;
     std::vector<numeric_condition::RegularNumericCondition> numeric_goals;
 
@@ -161,6 +206,28 @@ class PatternDatabase {
             const std::vector<ap_float> &operator_costs = std::vector<ap_float>(),
             bool dump = false);
 
+    /*
+      Moves the finite distances to a table indexed by the perfect hash
+      function and frees the state registry.
+    */
+    void build_perfect_hash_table();
+
+    // Returns true iff the PDB could be loaded from the cache.
+    bool load_from_cache(const pdbs::PDBCache &cache,
+                         std::size_t max_number_states,
+                         const std::vector<ap_float> &operator_costs);
+    void save_to_cache(const pdbs::PDBCache &cache,
+                       std::size_t max_number_states,
+                       const std::vector<ap_float> &operator_costs) const;
+
+    const ap_float *get_distances() const {
+        return cached_distances ? cached_distances : distances.data();
+    }
+
+    const std::size_t *get_perfect_hash_keys() const {
+        return cached_perfect_hash_keys ? cached_perfect_hash_keys : perfect_hash_keys.data();
+    }
+
     void create_pdb_propositional(
             size_t number_states,
             const std::vector<ap_float> &operator_costs = std::vector<ap_float>());
@@ -206,13 +273,16 @@ public:
        operator_costs: Can specify individual operator costs for each
        operator. This is useful for action cost partitioning. If left
        empty, default operator costs are used.
+       cache:          If given, the PDB is loaded from the cache if
+       possible and written to it otherwise.
     */
     PatternDatabase(
             const std::shared_ptr<numeric_pdb_helper::NumericTaskProxy> task_proxy,
             const Pattern &pattern,
             std::size_t max_number_states,
             bool dump = false,
-            const std::vector<ap_float> &operator_costs = std::vector<ap_float>());
+            const std::vector<ap_float> &operator_costs = std::vector<ap_float>(),
+            const std::shared_ptr<pdbs::PDBCache> &cache = nullptr);
 
     ~PatternDatabase() = default;
 
@@ -225,7 +295,19 @@ public:
 
     // Returns the size (number of abstract states) of the PDB
     std::size_t get_size() const {
-        return distances.size();
+        return num_abstract_states;
+    }
+
+    bool uses_perfect_hashing() const {
+        return use_perfect_hashing;
+    }
+
+    // Returns the (estimated) number of bytes used by the lookup structures
+    std::size_t estimate_memory_usage() const;
+
+    // Same as above, but before the state registry was replaced
+    std::size_t get_memory_usage_before_perfect_hashing() const {
+        return memory_before_perfect_hashing;
     }
 
     /*
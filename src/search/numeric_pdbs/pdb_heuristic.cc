@@ -6,6 +6,8 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../pdbs/pdb_cache.h"
+
 #include <limits>
 #include <memory>
 
@@ -19,7 +21,9 @@ PatternDatabase get_pdb_from_options(const shared_ptr<AbstractTask> &task,
         opts.get<shared_ptr<PatternGenerator>>("pattern");
     shared_ptr<NumericTaskProxy> task_proxy = make_shared<NumericTaskProxy>(task);
     Pattern pattern = pattern_generator->generate(task, task_proxy);
-    return {task_proxy, pattern, pattern_generator->get_max_number_pdb_states(), true};
+    shared_ptr<pdbs::PDBCache> cache = pdbs::create_pdb_cache_from_options(opts, *task);
+    return {task_proxy, pattern, pattern_generator->get_max_number_pdb_states(), true,
+            vector<ap_float>(), cache};
 }
 
 NumericPDBHeuristic::NumericPDBHeuristic(const Options &opts)
@@ -45,6 +49,7 @@ ap_float NumericPDBHeuristic::compute_heuristic(const State &state) const {
 }
 
 void NumericPDBHeuristic::print_statistics() const {
+    Heuristic::print_statistics();
     cout << "Number of failed heuristic lookups: " << number_lookup_misses << endl;
 }
 
@@ -62,6 +67,7 @@ static Heuristic *_parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy_numeric()");
+    pdbs::add_pdb_cache_options_to_parser(parser);
 
     Heuristic::add_options_to_parser(parser);
 
@@ -0,0 +1,155 @@
+#include "radix_open_list.h"
+
+#include "open_list.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+#include "../priority_queue.h"
+
+#include "../utils/memory.h"
+
+#include <cassert>
+#include <deque>
+#include <unordered_map>
+
+using namespace std;
+
+
+template<class Entry>
+class RadixOpenList : public OpenList<Entry> {
+    typedef deque<Entry> Bucket;
+
+    // Contains each key with a non-empty bucket exactly once.
+    RadixQueue<int> keys;
+    unordered_map<ap_float, Bucket> buckets;
+    int size;
+
+    ScalarEvaluator *evaluator;
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit RadixOpenList(const Options &opts);
+    virtual ~RadixOpenList() override = default;
+
+    virtual Entry remove_min(vector<ap_float> *key = nullptr) override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_involved_heuristics(set<Heuristic *> &hset) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+RadixOpenList<Entry>::RadixOpenList(const Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      size(0),
+      evaluator(opts.get<ScalarEvaluator *>("eval")) {
+}
+
+template<class Entry>
+void RadixOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    ap_float key = eval_context.get_heuristic_value(evaluator);
+    Bucket &bucket = buckets[key];
+    if (bucket.empty())
+        keys.push(key, 0);
+    bucket.push_back(entry);
+    ++size;
+}
+
+template<class Entry>
+Entry RadixOpenList<Entry>::remove_min(vector<ap_float> *key) {
+    assert(size > 0);
+    ap_float min_key = keys.pop().first;
+    auto it = buckets.find(min_key);
+    assert(it != buckets.end());
+    if (key) {
+        assert(key->empty());
+        key->push_back(min_key);
+    }
+
+    Bucket &bucket = it->second;
+    assert(!bucket.empty());
+    Entry result = bucket.front();
+    bucket.pop_front();
+    if (bucket.empty()) {
+        buckets.erase(it);
+    } else {
+        // Pushing the last removed key again is cheap.
+        keys.push(min_key, 0);
+    }
+    --size;
+    return result;
+}
+
+template<class Entry>
+bool RadixOpenList<Entry>::empty() const {
+    return size == 0;
+}
+
+template<class Entry>
+void RadixOpenList<Entry>::clear() {
+    keys.clear();
+    buckets.clear();
+    size = 0;
+}
+
+template<class Entry>
+void RadixOpenList<Entry>::get_involved_heuristics(
+    set<Heuristic *> &hset) {
+    evaluator->get_involved_heuristics(hset);
+}
+
+template<class Entry>
+bool RadixOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    return eval_context.is_heuristic_infinite(evaluator);
+}
+
+template<class Entry>
+bool RadixOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    return is_dead_end(eval_context) && evaluator->dead_ends_are_reliable();
+}
+
+RadixOpenListFactory::RadixOpenListFactory(
+    const Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+RadixOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<RadixOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+RadixOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<RadixOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Radix open list",
+        "Open list that uses a single evaluator and does not truncate "
+        "its values to integers. It is implemented as a radix heap and "
+        "is most efficient if the values of removed entries do not "
+        "decrease, e.g., for f-values with a consistent heuristic.");
+    parser.add_option<ScalarEvaluator *>("eval", "scalar evaluator");
+    parser.add_option<bool>(
+        "pref_only",
+        "insert only nodes generated by preferred operators", "false");
+
+    Options opts = parser.parse();
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<RadixOpenListFactory>(opts);
+}
+
+static PluginShared<OpenListFactory> _plugin("radix", _parse);
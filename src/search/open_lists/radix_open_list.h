@@ -0,0 +1,29 @@
+#ifndef OPEN_LISTS_RADIX_OPEN_LIST_H
+#define OPEN_LISTS_RADIX_OPEN_LIST_H
+
+#include "open_list_factory.h"
+
+#include "../option_parser_util.h"
+
+
+/*
+  Open list indexed by a single real value, using FIFO tie-breaking.
+
+  Unlike the standard open list, keys are not truncated to integers. The
+  distinct keys are kept in a RadixQueue and map to deques of entries.
+  This is efficient if the keys of removed entries do not decrease, as
+  for the f-values in A* with a consistent heuristic.
+*/
+
+
+class RadixOpenListFactory : public OpenListFactory {
+    Options options;
+public:
+    explicit RadixOpenListFactory(const Options &options);
+    virtual ~RadixOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+
+#endif
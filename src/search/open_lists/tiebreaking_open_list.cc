@@ -7,8 +7,11 @@
 
 #include "../utils/memory.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <deque>
+#include <functional>
 #include <map>
 #include <utility>
 #include <vector>
@@ -16,11 +19,229 @@
 using namespace std;
 
 
+/*
+  Buckets of entries with the same key, stored in a map ordered by key.
+  This supports any number of evaluators.
+*/
 template<class Entry>
-class TieBreakingOpenList : public OpenList<Entry> {
+class MapBuckets {
     using Bucket = deque<Entry>;
 
     map<const vector<ap_float>, Bucket> buckets;
+
+public:
+    void push(const vector<ap_float> &key, const Entry &entry) {
+        buckets[key].push_back(entry);
+    }
+
+    Entry pop_min(vector<ap_float> *key) {
+        typename map<const vector<ap_float>, Bucket>::iterator it;
+        it = buckets.begin();
+        assert(it != buckets.end());
+        assert(!it->second.empty());
+        if (key) {
+            assert(key->empty());
+            *key = it->first;
+        }
+        Entry result = it->second.front();
+        it->second.pop_front();
+        if (it->second.empty())
+            buckets.erase(it);
+        return result;
+    }
+
+    void clear() {
+        buckets.clear();
+    }
+};
+
+
+/*
+  Buckets for keys with exactly N components, which are stored inline in
+  fixed-size arrays. The buckets are found with an open-addressing hash
+  table (linear probing) and ordered by a binary heap of bucket indices.
+  The entries of all buckets are stored in singly linked FIFO lists in
+  one node pool. Nodes and buckets are recycled, so inserting and
+  removing entries does not allocate memory once the vectors have
+  reached their final size. Entries are removed in the same order as
+  with MapBuckets.
+*/
+template<class Entry, int N>
+class InlineKeyBuckets {
+    using Key = array<ap_float, N>;
+
+    struct Node {
+        Entry entry;
+        int next;
+
+        Node(const Entry &entry) : entry(entry), next(-1) {}
+    };
+
+    struct Bucket {
+        Key key;
+        int first_node;
+        int last_node;
+    };
+
+    vector<Node> nodes;
+    int first_free_node;
+    vector<Bucket> buckets;
+    vector<int> free_buckets;
+    // Indices of the non-empty buckets, the bucket with the smallest key first.
+    vector<int> heap;
+    // Hash table of the non-empty buckets (-1 for empty slots).
+    vector<int> table;
+
+    static size_t hash_key(const Key &key) {
+        size_t hash = 0;
+        for (ap_float value : key)
+            hash ^= std::hash<ap_float>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    size_t get_home_slot(const Key &key) const {
+        return hash_key(key) & (table.size() - 1);
+    }
+
+    bool heap_less(int bucket_1, int bucket_2) const {
+        // Inverted, since the standard heap functions build max-heaps.
+        return buckets[bucket_2].key < buckets[bucket_1].key;
+    }
+
+    void grow_table() {
+        vector<int> old_table;
+        old_table.swap(table);
+        table.assign(max<size_t>(16, 2 * old_table.size()), -1);
+        for (int bucket_id : old_table) {
+            if (bucket_id != -1) {
+                size_t slot = get_home_slot(buckets[bucket_id].key);
+                while (table[slot] != -1)
+                    slot = (slot + 1) & (table.size() - 1);
+                table[slot] = bucket_id;
+            }
+        }
+    }
+
+    int find_or_insert_bucket(const Key &key) {
+        if (2 * (heap.size() + 1) > table.size())
+            grow_table();
+        size_t slot = get_home_slot(key);
+        while (table[slot] != -1) {
+            if (buckets[table[slot]].key == key)
+                return table[slot];
+            slot = (slot + 1) & (table.size() - 1);
+        }
+        int bucket_id;
+        if (free_buckets.empty()) {
+            bucket_id = buckets.size();
+            buckets.emplace_back();
+        } else {
+            bucket_id = free_buckets.back();
+            free_buckets.pop_back();
+        }
+        Bucket &bucket = buckets[bucket_id];
+        bucket.key = key;
+        bucket.first_node = -1;
+        bucket.last_node = -1;
+        table[slot] = bucket_id;
+        heap.push_back(bucket_id);
+        push_heap(heap.begin(), heap.end(), [this](int lhs, int rhs) {
+                      return heap_less(lhs, rhs);
+                  });
+        return bucket_id;
+    }
+
+    void erase_from_table(int bucket_id) {
+        size_t mask = table.size() - 1;
+        size_t slot = get_home_slot(buckets[bucket_id].key);
+        while (table[slot] != bucket_id)
+            slot = (slot + 1) & mask;
+        // Backward shift deletion: move later entries of the probe sequence up.
+        size_t next = slot;
+        while (true) {
+            next = (next + 1) & mask;
+            if (table[next] == -1)
+                break;
+            size_t home = get_home_slot(buckets[table[next]].key);
+            // Move the entry unless its home slot lies cyclically in (slot, next].
+            bool stays = (slot <= next) ? (slot < home && home <= next)
+                                        : (slot < home || home <= next);
+            if (!stays) {
+                table[slot] = table[next];
+                slot = next;
+            }
+        }
+        table[slot] = -1;
+    }
+
+public:
+    InlineKeyBuckets() : first_free_node(-1) {}
+
+    void push(const vector<ap_float> &key_values, const Entry &entry) {
+        assert(key_values.size() == N);
+        Key key;
+        copy(key_values.begin(), key_values.end(), key.begin());
+        int bucket_id = find_or_insert_bucket(key);
+
+        int node_id;
+        if (first_free_node == -1) {
+            node_id = nodes.size();
+            nodes.emplace_back(entry);
+        } else {
+            node_id = first_free_node;
+            first_free_node = nodes[node_id].next;
+            nodes[node_id].entry = entry;
+            nodes[node_id].next = -1;
+        }
+
+        Bucket &bucket = buckets[bucket_id];
+        if (bucket.last_node == -1)
+            bucket.first_node = node_id;
+        else
+            nodes[bucket.last_node].next = node_id;
+        bucket.last_node = node_id;
+    }
+
+    Entry pop_min(vector<ap_float> *key) {
+        assert(!heap.empty());
+        int bucket_id = heap.front();
+        Bucket &bucket = buckets[bucket_id];
+        if (key) {
+            assert(key->empty());
+            key->assign(bucket.key.begin(), bucket.key.end());
+        }
+        int node_id = bucket.first_node;
+        assert(node_id != -1);
+        Entry result = nodes[node_id].entry;
+        bucket.first_node = nodes[node_id].next;
+        nodes[node_id].next = first_free_node;
+        first_free_node = node_id;
+
+        if (bucket.first_node == -1) {
+            erase_from_table(bucket_id);
+            pop_heap(heap.begin(), heap.end(), [this](int lhs, int rhs) {
+                         return heap_less(lhs, rhs);
+                     });
+            heap.pop_back();
+            free_buckets.push_back(bucket_id);
+        }
+        return result;
+    }
+
+    void clear() {
+        nodes.clear();
+        first_free_node = -1;
+        buckets.clear();
+        free_buckets.clear();
+        heap.clear();
+        table.clear();
+    }
+};
+
+
+template<class Entry, class Buckets>
+class TieBreakingOpenList : public OpenList<Entry> {
+    Buckets buckets;
     int size;
 
     vector<ScalarEvaluator *> evaluators;
@@ -30,6 +251,8 @@ class TieBreakingOpenList : public OpenList<Entry> {
       not a safe heuristic.
     */
     bool allow_unsafe_pruning;
+    // Reused for the keys of inserted entries to avoid allocations.
+    vector<ap_float> key;
 
     int dimension() const;
 
@@ -52,69 +275,56 @@ public:
 };
 
 
-template<class Entry>
-TieBreakingOpenList<Entry>::TieBreakingOpenList(const Options &opts)
+template<class Entry, class Buckets>
+TieBreakingOpenList<Entry, Buckets>::TieBreakingOpenList(const Options &opts)
     : OpenList<Entry>(opts.get<bool>("pref_only")),
       size(0), evaluators(opts.get_list<ScalarEvaluator *>("evals")),
       allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")) {
 }
 
-template<class Entry>
-void TieBreakingOpenList<Entry>::do_insertion(
+template<class Entry, class Buckets>
+void TieBreakingOpenList<Entry, Buckets>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<ap_float> key;
-    key.reserve(evaluators.size());
+    key.clear();
     for (ScalarEvaluator *evaluator : evaluators)
         key.push_back(eval_context.get_heuristic_value_or_infinity(evaluator));
 
-    buckets[key].push_back(entry);
+    buckets.push(key, entry);
     ++size;
 }
 
-template<class Entry>
-Entry TieBreakingOpenList<Entry>::remove_min(vector<ap_float> *key) {
+template<class Entry, class Buckets>
+Entry TieBreakingOpenList<Entry, Buckets>::remove_min(vector<ap_float> *key) {
     assert(size > 0);
-    typename map<const vector<ap_float>, Bucket>::iterator it;
-    it = buckets.begin();
-    assert(it != buckets.end());
-    assert(!it->second.empty());
     --size;
-    if (key) {
-        assert(key->empty());
-        *key = it->first;
-    }
-    Entry result = it->second.front();
-    it->second.pop_front();
-    if (it->second.empty())
-        buckets.erase(it);
-    return result;
+    return buckets.pop_min(key);
 }
 
-template<class Entry>
-bool TieBreakingOpenList<Entry>::empty() const {
+template<class Entry, class Buckets>
+bool TieBreakingOpenList<Entry, Buckets>::empty() const {
     return size == 0;
 }
 
-template<class Entry>
-void TieBreakingOpenList<Entry>::clear() {
+template<class Entry, class Buckets>
+void TieBreakingOpenList<Entry, Buckets>::clear() {
     buckets.clear();
     size = 0;
 }
 
-template<class Entry>
-int TieBreakingOpenList<Entry>::dimension() const {
+template<class Entry, class Buckets>
+int TieBreakingOpenList<Entry, Buckets>::dimension() const {
     return evaluators.size();
 }
 
-template<class Entry>
-void TieBreakingOpenList<Entry>::get_involved_heuristics(
+template<class Entry, class Buckets>
+void TieBreakingOpenList<Entry, Buckets>::get_involved_heuristics(
     set<Heuristic *> &hset) {
     for (ScalarEvaluator *evaluator : evaluators)
         evaluator->get_involved_heuristics(hset);
 }
 
-template<class Entry>
-bool TieBreakingOpenList<Entry>::is_dead_end(
+template<class Entry, class Buckets>
+bool TieBreakingOpenList<Entry, Buckets>::is_dead_end(
     EvaluationContext &eval_context) const {
     // TODO: Properly document this behaviour.
     // If one safe heuristic detects a dead end, return true.
@@ -132,8 +342,8 @@ bool TieBreakingOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template<class Entry>
-bool TieBreakingOpenList<Entry>::is_reliable_dead_end(
+template<class Entry, class Buckets>
+bool TieBreakingOpenList<Entry, Buckets>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
     for (ScalarEvaluator *evaluator : evaluators)
         if (eval_context.is_heuristic_infinite(evaluator) &&
@@ -146,14 +356,34 @@ TieBreakingOpenListFactory::TieBreakingOpenListFactory(const Options &options)
     : options(options) {
 }
 
+/*
+  Keys with up to four components (the common case) are stored inline,
+  longer keys in a map.
+*/
+template<class Entry>
+static unique_ptr<OpenList<Entry>> create_tiebreaking_open_list(const Options &options) {
+    switch (options.get_list<ScalarEvaluator *>("evals").size()) {
+    case 1:
+        return utils::make_unique_ptr<TieBreakingOpenList<Entry, InlineKeyBuckets<Entry, 1>>>(options);
+    case 2:
+        return utils::make_unique_ptr<TieBreakingOpenList<Entry, InlineKeyBuckets<Entry, 2>>>(options);
+    case 3:
+        return utils::make_unique_ptr<TieBreakingOpenList<Entry, InlineKeyBuckets<Entry, 3>>>(options);
+    case 4:
+        return utils::make_unique_ptr<TieBreakingOpenList<Entry, InlineKeyBuckets<Entry, 4>>>(options);
+    default:
+        return utils::make_unique_ptr<TieBreakingOpenList<Entry, MapBuckets<Entry>>>(options);
+    }
+}
+
 unique_ptr<StateOpenList>
 TieBreakingOpenListFactory::create_state_open_list() {
-    return utils::make_unique_ptr<TieBreakingOpenList<StateOpenListEntry>>(options);
+    return create_tiebreaking_open_list<StateOpenListEntry>(options);
 }
 
 unique_ptr<EdgeOpenList>
 TieBreakingOpenListFactory::create_edge_open_list() {
-    return utils::make_unique_ptr<TieBreakingOpenList<EdgeOpenListEntry>>(options);
+    return create_tiebreaking_open_list<EdgeOpenListEntry>(options);
 }
 
 static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
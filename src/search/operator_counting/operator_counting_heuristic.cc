@@ -2,6 +2,7 @@
 
 #include "constraint_generator.h"
 
+#include "../global_state.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
@@ -14,7 +15,10 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(const Options &opts)
     : Heuristic(opts),
       constraint_generators(
           opts.get_list<shared_ptr<ConstraintGenerator>>("constraint_generators")),
-    lp_solver(lp::LPSolverType(opts.get_enum("lpsolver")),lp::LPConstraintType(opts.get_enum("lprelaxation"))) {
+    lp_solver(lp::LPSolverType(opts.get_enum("lpsolver")),lp::LPConstraintType(opts.get_enum("lprelaxation"))),
+      max_stored_bases(opts.get<int>("max_stored_bases")),
+      reached_state_id(StateID::no_state),
+      reached_parent_id(StateID::no_state) {
 }
 
 OperatorCountingHeuristic::~OperatorCountingHeuristic() {
@@ -41,12 +45,32 @@ void OperatorCountingHeuristic::initialize() {
     lp_solver.load_problem(lp::LPObjectiveSense::MINIMIZE, variables, constraints);
 }
 
+bool OperatorCountingHeuristic::reach_state(
+    const GlobalState &parent_state, const GlobalOperator & /*op*/,
+    const GlobalState &state) {
+    reached_parent_id = parent_state.get_id();
+    reached_state_id = state.get_id();
+    return false;
+}
+
+void OperatorCountingHeuristic::store_basis(StateID state_id) {
+    auto inserted = bases.emplace(state_id, lp::LPBasis());
+    lp_solver.get_basis(inserted.first->second);
+    if (inserted.second) {
+        stored_basis_order.push_back(state_id);
+        if (static_cast<int>(stored_basis_order.size()) > max_stored_bases) {
+            bases.erase(stored_basis_order.front());
+            stored_basis_order.pop_front();
+        }
+    }
+}
+
 ap_float OperatorCountingHeuristic::compute_heuristic(const GlobalState &global_state) {
     State state = convert_global_state(global_state);
-    return compute_heuristic(state);
+    return compute_heuristic(state, global_state.get_id());
 }
 
-ap_float OperatorCountingHeuristic::compute_heuristic(const State &state) {
+ap_float OperatorCountingHeuristic::compute_heuristic(const State &state, StateID state_id) {
     assert(!lp_solver.has_temporary_constraints());
     for (auto generator : constraint_generators) {
         bool dead_end = generator->update_constraints(state, lp_solver);
@@ -55,12 +79,19 @@ ap_float OperatorCountingHeuristic::compute_heuristic(const State &state) {
             return DEAD_END;
         }
     }
+    if (state_id == reached_state_id) {
+        auto parent_basis = bases.find(reached_parent_id);
+        if (parent_basis != bases.end())
+            lp_solver.set_basis(parent_basis->second);
+    }
     ap_float result;
     lp_solver.solve();
     if (lp_solver.has_optimal_solution()) {
         double epsilon = 0.01;
         double objective_value = lp_solver.get_objective_value();
         result = ceil(objective_value - epsilon);
+        if (max_stored_bases > 0)
+            store_basis(state_id);
     } else {
         result = DEAD_END;
     }
@@ -68,6 +99,11 @@ ap_float OperatorCountingHeuristic::compute_heuristic(const State &state) {
     return result;
 }
 
+void OperatorCountingHeuristic::print_statistics() const {
+    Heuristic::print_statistics();
+    lp_solver.print_statistics();
+}
+
 static Heuristic *_parse(OptionParser &parser) {
     parser.document_synopsis(
         "Operator counting heuristic",
@@ -109,6 +145,13 @@ static Heuristic *_parse(OptionParser &parser) {
     parser.add_list_option<shared_ptr<ConstraintGenerator>>(
         "constraint_generators",
         "methods that generate constraints over operator counting variables");
+    parser.add_option<int>(
+        "max_stored_bases",
+        "maximum number of LP bases of evaluated states that are kept, so "
+        "the LP of a successor can start from the basis of its parent. "
+        "0 always starts from the basis of the last solved LP.",
+        "10000",
+        Bounds("0", "infinity"));
     lp::add_lp_solver_option_to_parser(parser);
     lp::add_lp_constraint_option_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
@@ -5,7 +5,9 @@
 
 #include "../lp/lp_solver.h"
 
+#include <deque>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace options {
@@ -18,13 +20,32 @@ class ConstraintGenerator;
 class OperatorCountingHeuristic : public Heuristic {
     std::vector<std::shared_ptr<ConstraintGenerator>> constraint_generators;
     lp::LPSolver lp_solver;
+
+    /*
+      LP bases of the most recently evaluated states. The LP of a state
+      reached with reach_state starts from the basis of its parent, which
+      differs from it in fewer bounds and landmarks than the LP solved last.
+      At most max_stored_bases are kept; the oldest are dropped first.
+    */
+    const int max_stored_bases;
+    std::unordered_map<StateID, lp::LPBasis> bases;
+    std::deque<StateID> stored_basis_order;
+    StateID reached_state_id;
+    StateID reached_parent_id;
+    void store_basis(StateID state_id);
 protected:
     virtual void initialize() override;
     virtual ap_float compute_heuristic(const GlobalState &global_state) override;
-    ap_float compute_heuristic(const State &state);
+    ap_float compute_heuristic(const State &state, StateID state_id);
 public:
     explicit OperatorCountingHeuristic(const options::Options &opts);
     ~OperatorCountingHeuristic();
+
+    virtual bool reach_state(
+        const GlobalState &parent_state, const GlobalOperator &op,
+        const GlobalState &state) override;
+
+    virtual void print_statistics() const override;
     int id_state;
 };
 }
@@ -7,6 +7,8 @@
 #include "type_documenter.h"
 
 #include "../globals.h"
+#include "../state_registry.h"
+#include "../successor_generator.h"
 
 #include "../ext/tree_util.hh"
 
@@ -349,6 +351,36 @@ SearchEngine *OptionParser::parse_cmd_line_aux(
             dp->print_all();
             cout << "Help output finished." << endl;
             exit(0);
+        } else if (arg.compare("--state-hash-table") == 0) {
+            if (is_last)
+                throw ArgError("missing argument after --state-hash-table");
+            ++i;
+            if (args[i] == "open_addressing") {
+                if (!dry_run) {
+                    // The global registry already exists at this point.
+                    g_use_open_addressing = true;
+                    g_state_registry->use_open_addressing();
+                }
+            } else if (args[i] != "standard") {
+                throw ArgError("unknown state hash table " + args[i]);
+            }
+        } else if (arg.compare("--successor-generator") == 0) {
+            if (is_last)
+                throw ArgError("missing argument after --successor-generator");
+            ++i;
+            if (args[i] == "flat") {
+                if (!dry_run)
+                    g_successor_generator->use_flat_representation();
+            } else if (args[i] != "tree") {
+                throw ArgError("unknown successor generator " + args[i]);
+            }
+        } else if (arg.compare("--benchmark-successor-generator") == 0) {
+            if (is_last)
+                throw ArgError("missing argument after --benchmark-successor-generator");
+            ++i;
+            int num_samples = parse_int_arg(arg, args[i]);
+            if (!dry_run)
+                benchmark_successor_generators(g_root_task(), num_samples);
         } else if (arg.compare("--internal-plan-file") == 0) {
             if (is_last)
                 throw ArgError("missing argument after --internal-plan-file");
@@ -374,7 +406,7 @@ string OptionParser::usage(string progname) {
         "usage: \n" +
         progname + " [OPTIONS] --search SEARCH < OUTPUT\n\n"
         "* SEARCH (SearchEngine): configuration of the search algorithm\n"
-        "* OUTPUT (filename): preprocessor output\n\n"
+        "* OUTPUT (filename): preprocessor output (text or binary format)\n\n"
         "Options:\n"
         "--help [NAME]\n"
         "    Prints help for all heuristics, open lists, etc. called NAME.\n"
@@ -387,6 +419,16 @@ string OptionParser::usage(string progname) {
         "    by the name that is specified in the definition.\n"
         "--random-seed SEED\n"
         "    Use random seed SEED\n\n"
+        "--state-hash-table {standard, open_addressing}\n"
+        "    Data structure used to detect duplicate states. The\n"
+        "    open-addressing table needs less memory and prints statistics\n"
+        "    about load factor and probe lengths.\n\n"
+        "--successor-generator {tree, flat}\n"
+        "    Representation of the successor generator. The flat generator\n"
+        "    stores the decision tree in contiguous arrays.\n\n"
+        "--benchmark-successor-generator NUM\n"
+        "    Time both successor generators on NUM states sampled with\n"
+        "    random walks before starting the search.\n\n"
         "--internal-plan-file FILENAME\n"
         "    Plan will be output to a file called FILENAME\n\n"
         "--internal-previous-portfolio-plans COUNTER\n"
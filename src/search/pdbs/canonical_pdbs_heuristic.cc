@@ -1,6 +1,7 @@
 #include "canonical_pdbs_heuristic.h"
 
 #include "pattern_generator.h"
+#include "pdb_cache.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -21,10 +22,14 @@ CanonicalPDBs get_canonical_pdbs_from_options(
     utils::Timer timer;
     PatternCollectionInformation pattern_collection_info =
         pattern_generator->generate(task);
+    shared_ptr<PDBCache> cache = create_pdb_cache_from_options(opts, *task);
+    pattern_collection_info.set_pdb_cache(cache);
     shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs();
     shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets =
         pattern_collection_info.get_max_additive_subsets();
     cout << "PDB collection construction time: " << timer << endl;
+    if (cache)
+        cache->print_statistics();
 
     bool dominance_pruning = opts.get<bool>("dominance_pruning");
     return CanonicalPDBs(pdbs, max_additive_subsets, dominance_pruning);
@@ -76,6 +81,7 @@ static Heuristic *_parse(OptionParser &parser) {
         "the heuristic value because there are dominating patterns in the "
         "collection.",
         "true");
+    add_pdb_cache_options_to_parser(parser);
 
     Heuristic::add_options_to_parser(parser);
 
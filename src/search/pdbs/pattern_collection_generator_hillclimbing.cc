@@ -532,6 +532,8 @@ static Heuristic *_parse_ipdb(OptionParser &parser) {
             "redundant_constraints", true);
     heuristic_opts.set<bool>( // TODO this is somewhat of a hack
             "rounding_up", false);
+    heuristic_opts.set<int>(
+        "projection_cache_memory", 0);
 
     // Note: in the long run, this should return a shared pointer.
     return new CanonicalPDBsHeuristic(heuristic_opts);
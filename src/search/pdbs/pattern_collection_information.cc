@@ -2,6 +2,7 @@
 
 #include "pattern_database.h"
 #include "max_additive_pdb_sets.h"
+#include "pdb_cache.h"
 #include "validation.h"
 
 #include <algorithm>
@@ -19,7 +20,8 @@ PatternCollectionInformation::PatternCollectionInformation(
       task_proxy(*task),
       patterns(patterns),
       pdbs(nullptr),
-      max_additive_subsets(nullptr) {
+      max_additive_subsets(nullptr),
+      pdb_cache(nullptr) {
     assert(patterns);
     validate_and_normalize_patterns(task_proxy, *patterns);
 }
@@ -74,7 +76,8 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
         pdbs = make_shared<PDBCollection>();
         for (const Pattern &pattern : *patterns) {
             shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern);
+                make_shared<PatternDatabase>(task_proxy, pattern, false,
+                                             vector<ap_float>(), pdb_cache);
             pdbs->push_back(pdb);
         }
     }
@@ -100,6 +103,10 @@ void PatternCollectionInformation::set_max_additive_subsets(
     assert(information_is_valid());
 }
 
+void PatternCollectionInformation::set_pdb_cache(shared_ptr<PDBCache> pdb_cache_) {
+    pdb_cache = pdb_cache_;
+}
+
 shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() {
     assert(patterns);
     return patterns;
@@ -8,6 +8,8 @@
 #include <memory>
 
 namespace pdbs {
+class PDBCache;
+
 /*
   This class contains everything we know about a pattern collection. It will
   always contain patterns, but can also contain the computed PDBs and maximal
@@ -23,6 +25,7 @@ class PatternCollectionInformation {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
+    std::shared_ptr<PDBCache> pdb_cache;
 
     void create_pdbs_if_missing();
     void create_max_additive_subsets_if_missing();
@@ -37,6 +40,8 @@ public:
     void set_pdbs(std::shared_ptr<PDBCollection> pdbs);
     void set_max_additive_subsets(
         std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets);
+    // Missing PDBs are loaded from and written to this cache.
+    void set_pdb_cache(std::shared_ptr<PDBCache> pdb_cache);
 
     std::shared_ptr<PatternCollection> get_patterns();
     std::shared_ptr<PDBCollection> get_pdbs();
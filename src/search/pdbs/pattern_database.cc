@@ -1,12 +1,14 @@
 #include "pattern_database.h"
 
 #include "match_tree.h"
+#include "pdb_cache.h"
 
 #include "../priority_queue.h"
 #include "../task_tools.h"
 
 #include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/mapped_file.h"
 #include "../utils/math.h"
 #include "../utils/timer.h"
 
@@ -71,9 +73,11 @@ PatternDatabase::PatternDatabase(
     const TaskProxy &task_proxy,
     const Pattern &pattern,
     bool dump,
-    const vector<ap_float> &operator_costs)
+    const vector<ap_float> &operator_costs,
+    const shared_ptr<PDBCache> &cache)
     : task_proxy(task_proxy),
-      pattern(pattern) {
+      pattern(pattern),
+      cached_distances(nullptr) {
     verify_no_non_numeric_axioms(task_proxy);
     verify_no_conditional_effects(task_proxy);
     assert(operator_costs.empty() ||
@@ -110,11 +114,49 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::CRITICAL_ERROR);
         }
     }
+    if (cache && load_from_cache(*cache, operator_costs)) {
+        if (dump)
+            cout << "PDB loaded from cache: " << timer << endl;
+        return;
+    }
     create_pdb(operator_costs);
+    if (cache)
+        save_to_cache(*cache, operator_costs);
     if (dump)
         cout << "PDB construction time: " << timer << endl;
 }
 
+static PDBFileWriter get_cache_key(const Pattern &pattern,
+                                   const vector<ap_float> &operator_costs) {
+    PDBFileWriter key;
+    key.write_vector(pattern);
+    key.write_vector(operator_costs);
+    return key;
+}
+
+bool PatternDatabase::load_from_cache(
+    const PDBCache &cache, const vector<ap_float> &operator_costs) {
+    PDBFileReader reader;
+    if (!cache.load(PDBType::CLASSICAL, get_cache_key(pattern, operator_costs), reader))
+        return false;
+    size_t num_distances;
+    const ap_float *values = reader.read_array<ap_float>(num_distances);
+    if (!reader.is_valid() || num_distances != num_states)
+        return false;
+    cache_file = reader.get_file();
+    cached_distances = values;
+    return true;
+}
+
+void PatternDatabase::save_to_cache(
+    const PDBCache &cache, const vector<ap_float> &operator_costs) const {
+    if (!cache.is_writing_enabled())
+        return;
+    PDBFileWriter content;
+    content.write_vector(distances);
+    cache.save(PDBType::CLASSICAL, get_cache_key(pattern, operator_costs), content);
+}
+
 void PatternDatabase::multiply_out(
     int pos, ap_float cost, vector<pair<int, int>> &prev_pairs,
     vector<pair<int, int>> &pre_pairs,
@@ -299,15 +341,16 @@ size_t PatternDatabase::hash_index(const State &state) const {
 }
 
 ap_float PatternDatabase::get_value(const State &state) const {
-    return distances[hash_index(state)];
+    return get_distances()[hash_index(state)];
 }
 
 double PatternDatabase::compute_mean_finite_h() const {
     ap_float sum = 0;
     int size = 0;
-    for (size_t i = 0; i < distances.size(); ++i) {
-        if (distances[i] != numeric_limits<int>::max()) {
-            sum += distances[i];
+    const ap_float *values = get_distances();
+    for (size_t i = 0; i < num_states; ++i) {
+        if (values[i] != numeric_limits<int>::max()) {
+            sum += values[i];
             ++size;
         }
     }
@@ -5,10 +5,17 @@
 
 #include "../task_proxy.h"
 
+#include <memory>
 #include <utility>
 #include <vector>
 
+namespace utils {
+class MappedFile;
+}
+
 namespace pdbs {
+class PDBCache;
+
 class AbstractOperator {
     /*
       This class represents an abstract operator how it is needed for
@@ -84,6 +91,13 @@ class PatternDatabase {
     */
     std::vector<ap_float> distances;
 
+    /*
+      If the PDB is loaded from the PDB cache, distances stays empty and
+      the h-values are read from the mapped cache file instead.
+    */
+    std::shared_ptr<utils::MappedFile> cache_file;
+    const ap_float *cached_distances;
+
     // multipliers for each variable for perfect hash function
     std::vector<std::size_t> hash_multipliers;
 
@@ -123,6 +137,16 @@ class PatternDatabase {
     void create_pdb(
         const std::vector<ap_float> &operator_costs = std::vector<ap_float>());
 
+    // Returns true iff the distances could be loaded from the cache.
+    bool load_from_cache(const PDBCache &cache,
+                         const std::vector<ap_float> &operator_costs);
+    void save_to_cache(const PDBCache &cache,
+                       const std::vector<ap_float> &operator_costs) const;
+
+    const ap_float *get_distances() const {
+        return cached_distances ? cached_distances : distances.data();
+    }
+
     /*
       Sets the pattern for the PDB and initializes hash_multipliers and
       num_states. operator_costs can specify individual operator costs
@@ -159,12 +183,15 @@ public:
        operator_costs: Can specify individual operator costs for each
        operator. This is useful for action cost partitioning. If left
        empty, default operator costs are used.
+       cache:          If given, the PDB is loaded from the cache if
+       possible and written to it otherwise.
     */
     PatternDatabase(
         const TaskProxy &task_proxy,
         const Pattern &pattern,
         bool dump = false,
-        const std::vector<ap_float> &operator_costs = std::vector<ap_float>());
+        const std::vector<ap_float> &operator_costs = std::vector<ap_float>(),
+        const std::shared_ptr<PDBCache> &cache = nullptr);
     ~PatternDatabase() = default;
 
     ap_float get_value(const State &state) const;
@@ -0,0 +1,301 @@
+#include "pdb_cache.h"
+
+#include "../abstract_task.h"
+#include "../option_parser.h"
+
+#include "../utils/mapped_file.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace pdbs {
+// Identifies cache files. Change the version if the file format changes.
+static const char CACHE_MAGIC[8] = {'P', 'D', 'B', 'C', 'A', 'C', 'H', 'E'};
+static const uint32_t CACHE_VERSION = 1;
+
+enum class CacheMode {
+    READ_WRITE,
+    READ,
+    WRITE
+};
+
+/*
+  FNV-1a hash of the binary representation of values. Unlike std::hash,
+  the result is the same in all runs and on all platforms with the same
+  byte order.
+*/
+class FingerprintHasher {
+    uint64_t hash;
+public:
+    FingerprintHasher() : hash(14695981039346656037ULL) {}
+
+    void add_bytes(const void *bytes, size_t num_bytes) {
+        const unsigned char *data = static_cast<const unsigned char *>(bytes);
+        for (size_t i = 0; i < num_bytes; ++i) {
+            hash ^= data[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    template<typename T>
+    void add(const T &value) {
+        add_bytes(&value, sizeof(T));
+    }
+
+    void add(const Fact &fact) {
+        add(fact.var);
+        add(fact.value);
+    }
+
+    template<typename T>
+    void add(const vector<T> &values) {
+        add(values.size());
+        for (const T &value : values)
+            add(value);
+    }
+
+    uint64_t get_hash() const {
+        return hash;
+    }
+};
+
+static void add_operator(FingerprintHasher &hasher, const AbstractTask &task,
+                         int op_id, bool is_axiom) {
+    hasher.add(task.get_operator_cost(op_id, is_axiom));
+    int num_preconditions = task.get_num_operator_preconditions(op_id, is_axiom);
+    hasher.add(num_preconditions);
+    for (int i = 0; i < num_preconditions; ++i)
+        hasher.add(task.get_operator_precondition(op_id, i, is_axiom));
+    int num_effects = task.get_num_operator_effects(op_id, is_axiom);
+    hasher.add(num_effects);
+    for (int i = 0; i < num_effects; ++i) {
+        hasher.add(task.get_operator_effect(op_id, i, is_axiom));
+        int num_conditions = task.get_num_operator_effect_conditions(op_id, i, is_axiom);
+        hasher.add(num_conditions);
+        for (int j = 0; j < num_conditions; ++j)
+            hasher.add(task.get_operator_effect_condition(op_id, i, j, is_axiom));
+    }
+    int num_ass_effects = task.get_num_operator_ass_effects(op_id, is_axiom);
+    hasher.add(num_ass_effects);
+    for (int i = 0; i < num_ass_effects; ++i) {
+        AssEffect effect = task.get_operator_ass_effect(op_id, i, is_axiom);
+        hasher.add(effect.aff_var);
+        hasher.add(static_cast<int>(effect.op_type));
+        hasher.add(effect.ass_var);
+        int num_conditions = task.get_num_operator_ass_effect_conditions(op_id, i, is_axiom);
+        hasher.add(num_conditions);
+        for (int j = 0; j < num_conditions; ++j)
+            hasher.add(task.get_operator_ass_effect_condition(op_id, i, j, is_axiom));
+    }
+}
+
+uint64_t compute_task_fingerprint(const AbstractTask &task) {
+    FingerprintHasher hasher;
+    int num_variables = task.get_num_variables();
+    hasher.add(num_variables);
+    for (int var = 0; var < num_variables; ++var)
+        hasher.add(task.get_variable_domain_size(var));
+    int num_numeric_variables = task.get_num_numeric_variables();
+    hasher.add(num_numeric_variables);
+    for (int var = 0; var < num_numeric_variables; ++var)
+        hasher.add(static_cast<int>(task.get_numeric_var_type(var)));
+
+    int num_operators = task.get_num_operators();
+    hasher.add(num_operators);
+    for (int op_id = 0; op_id < num_operators; ++op_id)
+        add_operator(hasher, task, op_id, false);
+    int num_axioms = task.get_num_axioms();
+    hasher.add(num_axioms);
+    for (int axiom_id = 0; axiom_id < num_axioms; ++axiom_id)
+        add_operator(hasher, task, axiom_id, true);
+
+    int num_cmp_axioms = task.get_num_cmp_axioms();
+    hasher.add(num_cmp_axioms);
+    for (int i = 0; i < num_cmp_axioms; ++i) {
+        hasher.add(task.get_comparison_axiom_effect(i, true));
+        hasher.add(task.get_comparison_axiom_effect(i, false));
+        hasher.add(task.get_comparison_axiom_argument(i, true));
+        hasher.add(task.get_comparison_axiom_argument(i, false));
+        hasher.add(static_cast<int>(task.get_comparison_axiom_operator(i)));
+    }
+    int num_ass_axioms = task.get_num_ass_axioms();
+    hasher.add(num_ass_axioms);
+    for (int i = 0; i < num_ass_axioms; ++i) {
+        hasher.add(task.get_assignment_axiom_effect(i));
+        hasher.add(task.get_assignment_axiom_argument(i, true));
+        hasher.add(task.get_assignment_axiom_argument(i, false));
+        hasher.add(static_cast<int>(task.get_assignment_axiom_operator(i)));
+    }
+
+    int num_goals = task.get_num_goals();
+    hasher.add(num_goals);
+    for (int i = 0; i < num_goals; ++i)
+        hasher.add(task.get_goal_fact(i));
+
+    hasher.add(task.get_initial_state_values());
+    hasher.add(task.get_initial_state_numeric_values());
+    return hasher.get_hash();
+}
+
+PDBFileReader::PDBFileReader()
+    : data(nullptr),
+      size(0),
+      pos(0),
+      valid(false) {
+}
+
+void PDBFileReader::open(shared_ptr<utils::MappedFile> file_, size_t offset) {
+    file = move(file_);
+    data = file->get_data();
+    size = file->get_size();
+    pos = offset;
+    valid = pos <= size;
+}
+
+const char *PDBFileReader::advance(size_t num_bytes) {
+    if (!valid || pos > size || num_bytes > size - pos) {
+        valid = false;
+        return nullptr;
+    }
+    const char *bytes = data + pos;
+    pos += num_bytes;
+    return bytes;
+}
+
+static bool parse_cache_mode(const options::Options &opts, bool read) {
+    CacheMode mode = static_cast<CacheMode>(opts.get_enum("pdb_cache_mode"));
+    if (read)
+        return mode == CacheMode::READ_WRITE || mode == CacheMode::READ;
+    return mode == CacheMode::READ_WRITE || mode == CacheMode::WRITE;
+}
+
+PDBCache::PDBCache(const options::Options &opts, const AbstractTask &task)
+    : directory(opts.get<string>("pdb_cache")),
+      read_enabled(parse_cache_mode(opts, true)),
+      write_enabled(parse_cache_mode(opts, false)),
+      task_fingerprint(compute_task_fingerprint(task)),
+      num_loaded(0),
+      num_written(0) {
+    cout << "PDB cache: " << directory << " (task fingerprint "
+         << hex << setw(16) << setfill('0') << task_fingerprint << dec << ")" << endl;
+}
+
+string PDBCache::get_filename(PDBType type, const PDBFileWriter &key) const {
+    FingerprintHasher hasher;
+    hasher.add(task_fingerprint);
+    hasher.add(type);
+    const vector<char> &key_data = key.get_data();
+    hasher.add_bytes(key_data.data(), key_data.size());
+    ostringstream filename;
+    filename << directory << "/" << hex << setw(16) << setfill('0')
+             << task_fingerprint << "-" << setw(16) << hasher.get_hash() << ".pdb";
+    return filename.str();
+}
+
+bool PDBCache::load(PDBType type, const PDBFileWriter &key, PDBFileReader &reader) const {
+    if (!read_enabled)
+        return false;
+    auto file = make_shared<utils::MappedFile>(get_filename(type, key));
+    if (!file->is_open())
+        return false;
+    reader.open(file, 0);
+    char magic[sizeof(CACHE_MAGIC)];
+    for (char &c : magic)
+        c = reader.read<char>();
+    if (!equal(magic, magic + sizeof(CACHE_MAGIC), CACHE_MAGIC) ||
+        reader.read<uint32_t>() != CACHE_VERSION ||
+        reader.read<PDBType>() != type ||
+        reader.read<uint64_t>() != task_fingerprint ||
+        reader.read_vector<char>() != key.get_data() ||
+        !reader.is_valid()) {
+        // The file is outdated or belongs to another task with the same hash.
+        return false;
+    }
+    uint64_t content_size = reader.read<uint64_t>();
+    if (!reader.is_valid() || content_size != reader.get_remaining_size()) {
+        // The file is truncated.
+        return false;
+    }
+    ++num_loaded;
+    return true;
+}
+
+void PDBCache::save(PDBType type, const PDBFileWriter &key, const PDBFileWriter &content) const {
+    if (!write_enabled)
+        return;
+    PDBFileWriter header;
+    for (char c : CACHE_MAGIC)
+        header.write(c);
+    header.write(CACHE_VERSION);
+    header.write(type);
+    header.write(task_fingerprint);
+    header.write_vector(key.get_data());
+    header.write<uint64_t>(content.get_data().size());
+    assert(header.get_data().size() % 8 == 0);
+
+    /*
+      Write to a temporary file first, so that other processes never see
+      a partially written file.
+    */
+    error_code error;
+    filesystem::create_directories(directory, error);
+    string filename = get_filename(type, key);
+    string tmp_filename = filename + ".tmp" + to_string(utils::get_process_id());
+    {
+        ofstream file(tmp_filename, ios::binary);
+        file.write(header.get_data().data(), header.get_data().size());
+        file.write(content.get_data().data(), content.get_data().size());
+        if (!file) {
+            cerr << "Warning: could not write PDB cache file " << tmp_filename << endl;
+            remove(tmp_filename.c_str());
+            return;
+        }
+    }
+    if (rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        cerr << "Warning: could not write PDB cache file " << filename << endl;
+        remove(tmp_filename.c_str());
+        return;
+    }
+    ++num_written;
+}
+
+void PDBCache::print_statistics() const {
+    cout << "PDBs loaded from cache: " << num_loaded << endl;
+    cout << "PDBs written to cache: " << num_written << endl;
+}
+
+void add_pdb_cache_options_to_parser(options::OptionParser &parser) {
+    parser.add_option<string>(
+        "pdb_cache",
+        "directory for cached PDBs. If given, PDBs are loaded from the cache "
+        "if they were built before for the same task, pattern and operator "
+        "costs, and new PDBs are written to the cache (see pdb_cache_mode).",
+        options::OptionParser::NONE);
+    vector<string> cache_modes;
+    vector<string> cache_modes_doc;
+    cache_modes.push_back("READ_WRITE");
+    cache_modes_doc.push_back("load cached PDBs and write new ones");
+    cache_modes.push_back("READ");
+    cache_modes_doc.push_back("only load cached PDBs");
+    cache_modes.push_back("WRITE");
+    cache_modes_doc.push_back("build all PDBs and write them to the cache");
+    parser.add_enum_option(
+        "pdb_cache_mode", cache_modes,
+        "how the PDB cache is used", "READ_WRITE", cache_modes_doc);
+}
+
+shared_ptr<PDBCache> create_pdb_cache_from_options(
+    const options::Options &opts, const AbstractTask &task) {
+    if (!opts.contains("pdb_cache"))
+        return nullptr;
+    return make_shared<PDBCache>(opts, task);
+}
+}
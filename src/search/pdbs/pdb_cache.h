@@ -0,0 +1,194 @@
+#ifndef PDBS_PDB_CACHE_H
+#define PDBS_PDB_CACHE_H
+
+#include "../globals.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class AbstractTask;
+
+namespace options {
+class OptionParser;
+class Options;
+}
+
+namespace utils {
+class MappedFile;
+}
+
+namespace pdbs {
+/*
+  Binary data of a cached PDB. Values are stored in native byte order.
+  Arrays are stored as their length followed by the elements and are
+  aligned to 8 bytes, so that a reader can use them in place in the
+  mapped file.
+*/
+class PDBFileWriter {
+    std::vector<char> data;
+
+    void pad() {
+        data.resize((data.size() + 7) / 8 * 8, 0);
+    }
+public:
+    template<typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain data can be written");
+        const char *bytes = reinterpret_cast<const char *>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    void write_array(const T *values, std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain data can be written");
+        write<std::uint64_t>(count);
+        pad();
+        const char *bytes = reinterpret_cast<const char *>(values);
+        data.insert(data.end(), bytes, bytes + count * sizeof(T));
+        pad();
+    }
+
+    template<typename T>
+    void write_vector(const std::vector<T> &values) {
+        write_array(values.data(), values.size());
+    }
+
+    const std::vector<char> &get_data() const {
+        return data;
+    }
+};
+
+/*
+  Reads the data written by a PDBFileWriter in the same order. If the
+  file is too short, all further reads return empty values and is_valid()
+  returns false, so callers only need to check once at the end.
+*/
+class PDBFileReader {
+    std::shared_ptr<utils::MappedFile> file;
+    const char *data;
+    std::size_t size;
+    std::size_t pos;
+    bool valid;
+
+    const char *advance(std::size_t num_bytes);
+    void skip_padding() {
+        pos = (pos + 7) / 8 * 8;
+    }
+public:
+    PDBFileReader();
+    void open(std::shared_ptr<utils::MappedFile> file, std::size_t offset);
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read");
+        T value{};
+        const char *bytes = advance(sizeof(T));
+        if (bytes)
+            std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    // Returns a pointer into the mapped file, which stays valid as long
+    // as the file returned by get_file() is alive.
+    template<typename T>
+    const T *read_array(std::size_t &count) {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read");
+        count = read<std::uint64_t>();
+        skip_padding();
+        if (valid && count > (size - std::min(pos, size)) / sizeof(T))
+            valid = false;
+        const char *bytes = advance(count * sizeof(T));
+        skip_padding();
+        if (!bytes) {
+            count = 0;
+            return nullptr;
+        }
+        assert(reinterpret_cast<std::uintptr_t>(bytes) % alignof(T) == 0);
+        return reinterpret_cast<const T *>(bytes);
+    }
+
+    template<typename T>
+    std::vector<T> read_vector() {
+        std::size_t count;
+        const T *values = read_array<T>(count);
+        if (!values)
+            return std::vector<T>();
+        return std::vector<T>(values, values + count);
+    }
+
+    bool is_valid() const {
+        return valid;
+    }
+
+    std::size_t get_remaining_size() const {
+        return valid ? size - pos : 0;
+    }
+
+    const std::shared_ptr<utils::MappedFile> &get_file() const {
+        return file;
+    }
+};
+
+enum class PDBType : std::uint32_t {
+    CLASSICAL = 1,
+    NUMERIC = 2
+};
+
+/*
+  Directory of cached PDBs. A cache file stores the fingerprint of the
+  task, the type of the PDB and a key, followed by the content written by
+  the PDB. The key contains everything the PDB depends on besides the
+  task, i.e., the pattern, the operator costs and construction limits.
+  A file is only used if fingerprint, type, key and size match. Files are
+  memory-mapped, so large distance tables are only read when accessed.
+*/
+class PDBCache {
+    const std::string directory;
+    const bool read_enabled;
+    const bool write_enabled;
+    const std::uint64_t task_fingerprint;
+
+    // for statistics only
+    mutable int num_loaded;
+    mutable int num_written;
+
+    std::string get_filename(PDBType type, const PDBFileWriter &key) const;
+public:
+    PDBCache(const options::Options &opts, const AbstractTask &task);
+
+    /*
+      Opens the cached PDB with the given type and key for reading and
+      returns true if it exists.
+    */
+    bool load(PDBType type, const PDBFileWriter &key, PDBFileReader &reader) const;
+
+    bool is_writing_enabled() const {
+        return write_enabled;
+    }
+
+    // Writes the content of a PDB with the given type and key to the cache.
+    void save(PDBType type, const PDBFileWriter &key, const PDBFileWriter &content) const;
+
+    void print_statistics() const;
+};
+
+/*
+  Computes a hash value of everything that defines the task (variables,
+  operators, axioms, goals and the initial state).
+*/
+extern std::uint64_t compute_task_fingerprint(const AbstractTask &task);
+
+extern void add_pdb_cache_options_to_parser(options::OptionParser &parser);
+
+// Returns nullptr if no cache directory is given in the options.
+extern std::shared_ptr<PDBCache> create_pdb_cache_from_options(
+    const options::Options &opts, const AbstractTask &task);
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "pdb_heuristic.h"
 
 #include "pattern_generator.h"
+#include "pdb_cache.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -18,7 +19,8 @@ PatternDatabase get_pdb_from_options(const shared_ptr<AbstractTask> task,
         opts.get<shared_ptr<PatternGenerator>>("pattern");
     Pattern pattern = pattern_generator->generate(task);
     TaskProxy task_proxy(*task);
-    return PatternDatabase(task_proxy, pattern, true);
+    shared_ptr<PDBCache> cache = create_pdb_cache_from_options(opts, *task);
+    return PatternDatabase(task_proxy, pattern, true, vector<ap_float>(), cache);
 }
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
@@ -52,6 +54,7 @@ static Heuristic *_parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy()");
+    add_pdb_cache_options_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
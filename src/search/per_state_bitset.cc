@@ -0,0 +1,63 @@
+#include "per_state_bitset.h"
+
+#include "global_state.h"
+#include "state_registry.h"
+
+#include "utils/collections.h"
+
+using namespace std;
+
+PerStateBitset::PerStateBitset(const vector<bool> &default_bits)
+    : num_bits(default_bits.size()),
+      // Use at least one block, because arrays of size 0 are not supported.
+      default_blocks(max(BitsetView::get_num_blocks(num_bits), 1), 0),
+      cached_registry(nullptr),
+      cached_entries(nullptr) {
+    BitsetView default_bitset(default_blocks.data(), num_bits);
+    for (int i = 0; i < num_bits; ++i) {
+        if (default_bits[i])
+            default_bitset.set(i);
+    }
+}
+
+PerStateBitset::~PerStateBitset() {
+    for (auto &entry : entries_by_registry) {
+        entry.first->unsubscribe(this);
+        delete entry.second;
+    }
+}
+
+PerStateBitset::BlockArrays *PerStateBitset::get_entries(const StateRegistry *registry) {
+    if (cached_registry != registry) {
+        cached_registry = registry;
+        auto it = entries_by_registry.find(registry);
+        if (it == entries_by_registry.end()) {
+            cached_entries = new BlockArrays(default_blocks.size());
+            entries_by_registry[registry] = cached_entries;
+            registry->subscribe(this);
+        } else {
+            cached_entries = it->second;
+        }
+    }
+    return cached_entries;
+}
+
+void PerStateBitset::remove_state_registry(StateRegistry *registry) {
+    delete entries_by_registry[registry];
+    entries_by_registry.erase(registry);
+    if (registry == cached_registry) {
+        cached_registry = nullptr;
+        cached_entries = nullptr;
+    }
+}
+
+BitsetView PerStateBitset::operator[](const GlobalState &state) {
+    const StateRegistry *registry = &state.get_registry();
+    BlockArrays *entries = get_entries(registry);
+    int state_id = state.get_id().value;
+    assert(utils::in_bounds(state_id, *registry));
+    size_t virtual_size = registry->size();
+    if (entries->size() < virtual_size)
+        entries->resize(virtual_size, default_blocks.data());
+    return BitsetView((*entries)[state_id], num_bits);
+}
@@ -0,0 +1,124 @@
+#ifndef PER_STATE_BITSET_H
+#define PER_STATE_BITSET_H
+
+#include "per_state_information.h"
+#include "segmented_vector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class GlobalState;
+class StateRegistry;
+
+/*
+  View of a bitset of fixed size stored in a PerStateBitset. The bits are
+  stored in blocks of 64 bits, and unused bits of the last block are always
+  0, so that word-wise operations on the blocks need no special cases.
+*/
+class BitsetView {
+public:
+    typedef std::uint64_t Block;
+    static const int BITS_PER_BLOCK = 64;
+
+private:
+    Block *blocks;
+    int num_bits;
+
+public:
+    BitsetView(Block *blocks, int num_bits)
+        : blocks(blocks), num_bits(num_bits) {
+    }
+
+    static int get_num_blocks(int num_bits) {
+        return (num_bits + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+    }
+
+    // Returns a mask of the bits of the given block that belong to the bitset.
+    static Block get_valid_mask(int num_bits, int block_index) {
+        int num_valid = num_bits - block_index * BITS_PER_BLOCK;
+        if (num_valid >= BITS_PER_BLOCK)
+            return ~Block(0);
+        return (Block(1) << num_valid) - 1;
+    }
+
+    bool test(int index) const {
+        assert(index >= 0 && index < num_bits);
+        return (blocks[index / BITS_PER_BLOCK] >> (index % BITS_PER_BLOCK)) & 1;
+    }
+
+    void set(int index) {
+        assert(index >= 0 && index < num_bits);
+        blocks[index / BITS_PER_BLOCK] |= Block(1) << (index % BITS_PER_BLOCK);
+    }
+
+    void reset(int index) {
+        assert(index >= 0 && index < num_bits);
+        blocks[index / BITS_PER_BLOCK] &= ~(Block(1) << (index % BITS_PER_BLOCK));
+    }
+
+    void reset() {
+        for (int i = 0; i < get_num_blocks(); ++i)
+            blocks[i] = 0;
+    }
+
+    void copy_from(const BitsetView &other) {
+        assert(num_bits == other.num_bits);
+        for (int i = 0; i < get_num_blocks(); ++i)
+            blocks[i] = other.blocks[i];
+    }
+
+    int size() const {
+        return num_bits;
+    }
+
+    int get_num_blocks() const {
+        return get_num_blocks(num_bits);
+    }
+
+    Block *get_blocks() {
+        return blocks;
+    }
+
+    const Block *get_blocks() const {
+        return blocks;
+    }
+};
+
+/*
+  PerStateBitset associates a bitset of fixed size with every state, like
+  PerStateInformation<std::vector<bool>>. Instead of allocating a vector for
+  every state, the blocks of all bitsets of a registry are stored with a
+  fixed stride in one SegmentedArrayVector. States that were not accessed
+  before get the default bitset.
+
+  The storage of a bitset does not move when bitsets for further states
+  are added, so the returned views stay valid as long as the state
+  registry exists.
+*/
+class PerStateBitset : public PerStateInformationBase {
+    const int num_bits;
+    std::vector<BitsetView::Block> default_blocks;
+
+    typedef SegmentedArrayVector<BitsetView::Block> BlockArrays;
+    std::unordered_map<const StateRegistry *, BlockArrays *> entries_by_registry;
+
+    const StateRegistry *cached_registry;
+    BlockArrays *cached_entries;
+
+    BlockArrays *get_entries(const StateRegistry *registry);
+
+    virtual void remove_state_registry(StateRegistry *registry) override;
+
+    // No implementation to forbid copies and assignment
+    PerStateBitset(const PerStateBitset &);
+    PerStateBitset &operator=(const PerStateBitset &);
+public:
+    explicit PerStateBitset(const std::vector<bool> &default_bits);
+    virtual ~PerStateBitset() override;
+
+    BitsetView operator[](const GlobalState &state);
+};
+
+#endif
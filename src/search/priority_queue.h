@@ -4,16 +4,20 @@
 #include "utils/collections.h"
 #include "globals.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <queue>
 #include <utility>
 #include <vector>
 
 /*
-  We define three priority queue classes here: HeapQueue (heap-based),
-  BucketQueue (bucket-based), and AdaptiveQueue (starts out bucket-based,
-  transforms into heap-based if that seems to make sense).
+  We define four priority queue classes here: HeapQueue (heap-based),
+  BucketQueue (bucket-based), AdaptiveQueue (starts out bucket-based,
+  transforms into heap-based if that seems to make sense) and RadixQueue
+  (radix heap for real-valued keys).
 
   More precisely, an AdaptiveQueue is converted from a BucketQueue to
   a HeapQueue when the number of required buckets exceeds both
@@ -225,6 +229,121 @@ public:
 };
 
 
+/*
+  Radix heap (Ahuja, Mehlhorn, Orlin and Tarjan, 1990) for real-valued
+  keys. Keys are mapped to unsigned integers with the same order through
+  their IEEE bit patterns. An entry is stored in the bucket given by the
+  most significant bit in which its key differs from the key of the last
+  removed entry, so the buckets only need to be sorted out when bucket 0
+  runs empty. Every entry moves to a lower bucket at most 64 times.
+
+  Like BucketQueue, the queue is meant for monotone explorations such as
+  Dijkstra's algorithm, where no key is smaller than the last removed
+  key. Smaller keys are handled correctly, but require redistributing all
+  entries. Entries with the same key are not necessarily removed in the
+  order in which they were added.
+*/
+template<typename Value>
+class RadixQueue : public AbstractQueue<Value> {
+    typedef typename AbstractQueue<Value>::Entry Entry;
+
+    static const int NUM_BUCKETS = 65;
+
+    struct Item {
+        uint64_t radix;
+        Entry entry;
+
+        Item(uint64_t radix, const Entry &entry) : radix(radix), entry(entry) {}
+    };
+
+    typedef std::vector<Item> Bucket;
+    Bucket buckets[NUM_BUCKETS];
+    Bucket scratch;
+    uint64_t last_radix;
+    int num_entries;
+
+    static uint64_t to_radix(ap_float key) {
+        static_assert(sizeof(ap_float) == sizeof(uint64_t), "keys must be 64-bit floats");
+        const uint64_t sign_bit = uint64_t(1) << 63;
+        // Treat -0 like 0.
+        if (key == 0)
+            key = 0;
+        uint64_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        // Negative numbers are ordered in reverse by their bit patterns.
+        return (bits & sign_bit) ? ~bits : bits | sign_bit;
+    }
+
+    int get_bucket(uint64_t radix) const {
+        assert(radix >= last_radix);
+        if (radix == last_radix)
+            return 0;
+        return 64 - __builtin_clzll(radix ^ last_radix);
+    }
+
+    void redistribute(int bucket_no, uint64_t new_last_radix) {
+        last_radix = new_last_radix;
+        scratch.swap(buckets[bucket_no]);
+        for (const Item &item : scratch)
+            buckets[get_bucket(item.radix)].push_back(item);
+        scratch.clear();
+    }
+
+public:
+    RadixQueue() : last_radix(0), num_entries(0) {
+    }
+
+    virtual ~RadixQueue() {
+    }
+
+    virtual void push(ap_float key, const Value &value) {
+        uint64_t radix = to_radix(key);
+        if (radix < last_radix) {
+            // The key is smaller than the last removed key.
+            last_radix = radix;
+            for (int i = 0; i < NUM_BUCKETS; ++i) {
+                if (!buckets[i].empty())
+                    redistribute(i, radix);
+            }
+        }
+        buckets[get_bucket(radix)].push_back(Item(radix, std::make_pair(key, value)));
+        ++num_entries;
+    }
+
+    virtual Entry pop() {
+        assert(num_entries > 0);
+        if (buckets[0].empty()) {
+            int bucket_no = 1;
+            while (buckets[bucket_no].empty())
+                ++bucket_no;
+            uint64_t min_radix = buckets[bucket_no][0].radix;
+            for (const Item &item : buckets[bucket_no])
+                min_radix = std::min(min_radix, item.radix);
+            redistribute(bucket_no, min_radix);
+            assert(!buckets[0].empty());
+        }
+        --num_entries;
+        Entry result = buckets[0].back().entry;
+        buckets[0].pop_back();
+        return result;
+    }
+
+    virtual bool empty() const {
+        return num_entries == 0;
+    }
+
+    virtual void clear() {
+        for (int i = 0; i < NUM_BUCKETS; ++i)
+            buckets[i].clear();
+        last_radix = 0;
+        num_entries = 0;
+    }
+
+    virtual void add_virtual_pushes(int /*num_extra_pushes*/) {
+    }
+};
+
+
 template<typename Value>
 class AdaptiveQueue {
     AbstractQueue<Value> *wrapped_queue;
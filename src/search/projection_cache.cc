@@ -0,0 +1,90 @@
+#include "projection_cache.h"
+
+#include "task_proxy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+static const int INTS_PER_NUMERIC_VALUE =
+    (sizeof(ap_float) + sizeof(int) - 1) / sizeof(int);
+
+// Estimated overhead of each of the three allocations per entry.
+static const size_t ALLOCATION_OVERHEAD_IN_BYTES = 16;
+
+ProjectionCache::ProjectionCache(vector<int> &&variables_,
+                                 vector<int> &&numeric_variables_,
+                                 size_t memory_limit_in_bytes)
+    : variables(move(variables_)),
+      numeric_variables(move(numeric_variables_)),
+      num_lookups(0),
+      num_hits(0),
+      num_evictions(0) {
+    size_t key_size = variables.size() + numeric_variables.size() * INTS_PER_NUMERIC_VALUE;
+    key.resize(key_size);
+    /*
+      Each entry consists of a hash table node (key, entry, next pointer and
+      cached hash value), a bucket pointer, a list node (two pointers and
+      the key pointer) and the key values.
+    */
+    size_t entry_size = sizeof(Key) + sizeof(Entry) + 6 * sizeof(void *) +
+        3 * ALLOCATION_OVERHEAD_IN_BYTES + key_size * sizeof(int);
+    max_entries = max<size_t>(1, memory_limit_in_bytes / entry_size);
+    entries.reserve(max_entries);
+    cout << "Projection cache: " << variables.size() << " variables, "
+         << numeric_variables.size() << " numeric variables, at most "
+         << max_entries << " entries" << endl;
+}
+
+void ProjectionCache::compute_key(const State &state) const {
+    int *values = key.data();
+    for (int var : variables)
+        *values++ = state[var].get_value();
+    for (int var : numeric_variables) {
+        ap_float value = state.nval(var);
+        memcpy(values, &value, sizeof(ap_float));
+        values += INTS_PER_NUMERIC_VALUE;
+    }
+}
+
+bool ProjectionCache::lookup(const State &state, ap_float &h) {
+    ++num_lookups;
+    compute_key(state);
+    auto it = entries.find(key);
+    if (it == entries.end())
+        return false;
+    ++num_hits;
+    lru.splice(lru.begin(), lru, it->second.lru_position);
+    h = it->second.h;
+    return true;
+}
+
+void ProjectionCache::insert(const State &state, ap_float h) {
+    compute_key(state);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.h = h;
+        lru.splice(lru.begin(), lru, it->second.lru_position);
+        return;
+    }
+    if (entries.size() >= max_entries) {
+        entries.erase(entries.find(*lru.back()));
+        lru.pop_back();
+        ++num_evictions;
+    }
+    // References to elements of an unordered_map stay valid on rehashing.
+    it = entries.emplace(key, Entry{h, LRUList::iterator()}).first;
+    lru.push_front(&it->first);
+    it->second.lru_position = lru.begin();
+}
+
+void ProjectionCache::print_statistics() const {
+    cout << "Projection cache lookups: " << num_lookups << endl;
+    cout << "Projection cache hits: " << num_hits << endl;
+    cout << "Projection cache hit rate: "
+         << (num_lookups ? static_cast<double>(num_hits) / num_lookups : 0) << endl;
+    cout << "Projection cache entries: " << entries.size() << endl;
+    cout << "Projection cache evictions: " << num_evictions << endl;
+}
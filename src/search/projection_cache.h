@@ -0,0 +1,63 @@
+#ifndef PROJECTION_CACHE_H
+#define PROJECTION_CACHE_H
+
+#include "globals.h"
+
+#include "utils/hash.h"
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+class State;
+
+/*
+  Bounded cache of heuristic values keyed by the projection of a state
+  onto a subset of its (regular and numeric) variables. States that only
+  differ in the other variables share an entry. If the cache is full, the
+  least recently used entry is replaced.
+
+  The key of a state consists of the values of the regular variables
+  followed by the bit patterns of the numeric values. Numeric values are
+  compared bitwise, so 0 and -0 have different keys.
+*/
+class ProjectionCache {
+    using Key = std::vector<int>;
+    // Most recently used entries first.
+    using LRUList = std::list<const Key *>;
+    struct Entry {
+        ap_float h;
+        LRUList::iterator lru_position;
+    };
+
+    const std::vector<int> variables;
+    const std::vector<int> numeric_variables;
+    std::size_t max_entries;
+    std::unordered_map<Key, Entry> entries;
+    LRUList lru;
+    // Reused to avoid allocations in lookups.
+    mutable Key key;
+
+    // for statistics only
+    int num_lookups;
+    int num_hits;
+    int num_evictions;
+
+    void compute_key(const State &state) const;
+public:
+    ProjectionCache(std::vector<int> &&variables,
+                    std::vector<int> &&numeric_variables,
+                    std::size_t memory_limit_in_bytes);
+
+    /*
+      Returns true and sets h to the cached value if the projection of
+      state has an entry. Counts as a lookup in the statistics.
+    */
+    bool lookup(const State &state, ap_float &h);
+    void insert(const State &state, ap_float h);
+
+    void print_statistics() const;
+};
+
+#endif
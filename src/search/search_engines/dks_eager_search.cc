@@ -79,13 +79,7 @@ void DksEagerSearch::initialize() {
     assert(!heuristics.empty());
 
     const GlobalState &initial_state = g_state_registry->get_initial_state();
-    std::vector<container_int> values(g_variable_domain.size());
-    for (size_t i = 0; i < g_variable_domain.size(); ++i) {
-        values[i] = initial_state[i];
-    }
-    std::vector<ap_float> numeric_values = initial_state.get_numeric_vars();
-    g_symmetry_graph->get_canonical_state(values, numeric_values);
-    GlobalState canonical_initial_state = g_state_registry->register_state(values, numeric_values);
+    GlobalState canonical_initial_state = get_canonical_state(initial_state);
     canonical_to_state_id[canonical_initial_state] = initial_state.get_id();
 
     // Note: we consider the initial state as reached by a preferred
@@ -184,13 +178,7 @@ SearchStatus DksEagerSearch::step() {
             continue;
 
         GlobalState succ_state = g_state_registry->get_successor_state(s, *op);
-        std::vector<container_int> values(g_variable_domain.size());
-        for (size_t i = 0; i < g_variable_domain.size(); ++i) {
-            values[i] = succ_state[i];
-        }
-        std::vector<ap_float> numeric_values = succ_state.get_numeric_vars();
-        g_symmetry_graph->get_canonical_state(values, numeric_values);
-        GlobalState canonical_succ_state = g_state_registry->register_state(values, numeric_values);
+        GlobalState canonical_succ_state = get_canonical_state(succ_state);
 
         StateID previous_state_id = canonical_to_state_id[canonical_succ_state];
         bool is_new = previous_state_id == StateID::no_state;
@@ -319,6 +307,16 @@ SearchStatus DksEagerSearch::step() {
     return IN_PROGRESS;
 }
 
+GlobalState DksEagerSearch::get_canonical_state(const GlobalState &state) {
+    canonical_values.resize(g_variable_domain.size());
+    for (size_t i = 0; i < g_variable_domain.size(); ++i) {
+        canonical_values[i] = state[i];
+    }
+    g_state_registry->get_numeric_vars(state, canonical_numeric_values);
+    g_symmetry_graph->get_canonical_state(canonical_values, canonical_numeric_values);
+    return g_state_registry->register_state(canonical_values, canonical_numeric_values);
+}
+
 pair<SearchNode, bool> DksEagerSearch::fetch_next_node() {
     /* TODO: The bulk of this code deals with multi-path dependence,
        which is a bit unfortunate since that is a special case that
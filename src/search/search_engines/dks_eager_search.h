@@ -31,6 +31,11 @@ class DksEagerSearch : public SearchEngine {
     std::shared_ptr<PruningMethod> pruning_method;
 
     PerStateInformation<StateID> canonical_to_state_id;
+    // Scratch space for computing canonical states.
+    std::vector<container_int> canonical_values;
+    std::vector<ap_float> canonical_numeric_values;
+
+    GlobalState get_canonical_state(const GlobalState &state);
 
     std::pair<SearchNode, bool> fetch_next_node();
     void start_f_value_statistics(EvaluationContext &eval_context);
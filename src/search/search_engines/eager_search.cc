@@ -8,6 +8,7 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 #include "../pruning_method.h"
+#include "../state_registry.h"
 #include "../successor_generator.h"
 #include "../utils/timer.h"
 #include "../utils/planvis.h"
@@ -6,6 +6,7 @@
 #include "../heuristic.h"
 #include "../option_parser.h"
 #include "../plugin.h"
+#include "../state_registry.h"
 #include "../successor_generator.h"
 
 #include "../open_lists/open_list_factory.h"
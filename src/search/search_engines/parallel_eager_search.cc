@@ -0,0 +1,460 @@
+#include "parallel_eager_search.h"
+
+#include "../axioms.h"
+#include "../evaluation_context.h"
+#include "../globals.h"
+#include "../heuristic.h"
+#include "../option_parser.h"
+#include "../per_state_information.h"
+#include "../plugin.h"
+#include "../state_registry.h"
+#include "../successor_generator.h"
+
+#include "../utils/hash.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <queue>
+#include <thread>
+
+using namespace std;
+
+namespace parallel_eager_search {
+/*
+  A generated state on its way to its owner. States are transferred
+  unpacked because the packed representation depends on the registry.
+  Messages are reused (see Worker::get_message), so their vectors are
+  only allocated while they grow to the size of a state.
+*/
+struct Message {
+    vector<container_int> values;
+    vector<ap_float> numeric_values;
+    ap_float g;
+    ap_float real_g;
+    int parent_worker;
+    StateID parent_id;
+    const GlobalOperator *creating_operator;
+    Message *next;
+
+    Message()
+        : g(0),
+          real_g(0),
+          parent_worker(-1),
+          parent_id(StateID::no_state),
+          creating_operator(nullptr),
+          next(nullptr) {
+    }
+};
+
+/*
+  Lock-free queue with many senders and a single receiver. Senders push
+  onto a linked stack, the receiver takes the whole stack at once.
+*/
+class MessageQueue {
+    atomic<Message *> head;
+public:
+    MessageQueue()
+        : head(nullptr) {
+    }
+
+    ~MessageQueue() {
+        Message *message = head.load();
+        while (message) {
+            Message *next = message->next;
+            delete message;
+            message = next;
+        }
+    }
+
+    void push(Message *message) {
+        message->next = head.load(memory_order_relaxed);
+        while (!head.compare_exchange_weak(message->next, message,
+                                           memory_order_release,
+                                           memory_order_relaxed)) {
+        }
+    }
+
+    // Returns the received messages in the order they were sent.
+    Message *take_all() {
+        Message *message = head.exchange(nullptr, memory_order_acquire);
+        Message *reversed = nullptr;
+        while (message) {
+            Message *next = message->next;
+            message->next = reversed;
+            reversed = message;
+            message = next;
+        }
+        return reversed;
+    }
+};
+
+struct NodeInfo {
+    ap_float g; // -1 for states that have not been reached yet
+    ap_float real_g;
+    ap_float h;
+    int parent_worker;
+    StateID parent_id;
+    const GlobalOperator *creating_operator;
+
+    NodeInfo()
+        : g(-1),
+          real_g(-1),
+          h(0),
+          parent_worker(-1),
+          parent_id(StateID::no_state),
+          creating_operator(nullptr) {
+    }
+};
+
+struct OpenEntry {
+    ap_float f;
+    ap_float h;
+    ap_float g;
+    StateID id;
+
+    // Lowest f first, ties are broken in favor of lower h.
+    bool operator<(const OpenEntry &other) const {
+        if (f != other.f)
+            return f > other.f;
+        return h > other.h;
+    }
+};
+
+struct Worker {
+    /*
+      Used by the registry and by State::get_successor in this worker's
+      thread. Not shared because it has scratch data.
+    */
+    unique_ptr<AxiomEvaluator> axiom_evaluator;
+    StateRegistry registry;
+    Heuristic *heuristic;
+    PerStateInformation<NodeInfo> node_infos;
+    priority_queue<OpenEntry> open_list;
+    MessageQueue inbox;
+
+    /*
+      Messages sent by this worker are returned to it by their receivers
+      through returned_messages. The sender takes them from there when its
+      own list of free messages is empty.
+    */
+    Message *free_messages;
+    MessageQueue returned_messages;
+
+    // Statistics.
+    int expanded;
+    int evaluated;
+    int generated;
+    int reopened;
+    int dead_ends;
+    int sent;
+
+    Worker(int num_numeric_constants, Heuristic *heuristic)
+        : axiom_evaluator(utils::make_unique_ptr<AxiomEvaluator>()),
+          registry(num_numeric_constants, axiom_evaluator.get()),
+          heuristic(heuristic),
+          free_messages(nullptr),
+          expanded(0),
+          evaluated(0),
+          generated(0),
+          reopened(0),
+          dead_ends(0),
+          sent(0) {
+        // Sets up the layout of the numeric variables in the registry.
+        registry.get_initial_state();
+    }
+
+    ~Worker() {
+        while (free_messages) {
+            Message *next = free_messages->next;
+            delete free_messages;
+            free_messages = next;
+        }
+    }
+
+    Message *get_message() {
+        if (!free_messages)
+            free_messages = returned_messages.take_all();
+        if (!free_messages)
+            return new Message();
+        Message *message = free_messages;
+        free_messages = message->next;
+        message->next = nullptr;
+        return message;
+    }
+};
+
+static int count_numeric_constants() {
+    return count(g_numeric_var_types.begin(), g_numeric_var_types.end(), constant);
+}
+
+ParallelEagerSearch::ParallelEagerSearch(const Options &opts)
+    : SearchEngine(opts),
+      heuristic_config(opts.get<ParseTree>("heuristic")),
+      num_threads(opts.get<int>("threads")),
+      incumbent_cost(INF),
+      incumbent_worker(-1),
+      incumbent_state(StateID::no_state),
+      num_busy(0) {
+}
+
+ParallelEagerSearch::~ParallelEagerSearch() {
+}
+
+void ParallelEagerSearch::initialize() {
+    cout << "Conducting hash-distributed A* search with " << num_threads
+         << " threads" << endl;
+    int num_numeric_constants = count_numeric_constants();
+    for (int i = 0; i < num_threads; ++i) {
+        OptionParser parser(heuristic_config, false);
+        Heuristic *heuristic = parser.start_parsing<Heuristic *>();
+        for (const unique_ptr<Worker> &worker : workers) {
+            if (worker->heuristic == heuristic) {
+                cerr << "Every thread needs its own heuristic. Do not use "
+                     << "predefined heuristics with hdastar." << endl;
+                utils::exit_with(utils::ExitCode::INPUT_ERROR);
+            }
+        }
+        workers.emplace_back(new Worker(num_numeric_constants, heuristic));
+    }
+
+    const GlobalState &initial_state = g_initial_state();
+    Message *message = new Message();
+    for (size_t var = 0; var < g_variable_domain.size(); ++var)
+        message->values.push_back(initial_state[var]);
+    message->numeric_values = initial_state.get_numeric_vars();
+    send(message);
+}
+
+int ParallelEagerSearch::get_owner(const Message &message) const {
+    // Only the variables stored in the state buffer determine the owner.
+    size_t hash = 0;
+    utils::hash_combine(hash, message.values);
+    for (size_t var = 0; var < message.numeric_values.size(); ++var) {
+        if (g_numeric_var_types[var] == regular)
+            utils::hash_combine(hash, message.numeric_values[var]);
+    }
+    return hash % num_threads;
+}
+
+void ParallelEagerSearch::send(Message *message) {
+    ++num_busy;
+    workers[get_owner(*message)]->inbox.push(message);
+}
+
+void ParallelEagerSearch::receive(Worker &worker, Message &message) {
+    GlobalState state = worker.registry.register_state(message.values, message.numeric_values);
+    NodeInfo &info = worker.node_infos[state];
+    bool is_new = info.g < 0;
+    if (!is_new) {
+        if (info.h == INF || info.g <= message.g)
+            return;
+        ++worker.reopened;
+    }
+    info.g = message.g;
+    info.real_g = message.real_g;
+    info.parent_worker = message.parent_worker;
+    info.parent_id = message.parent_id;
+    info.creating_operator = message.creating_operator;
+
+    if (is_new) {
+        EvaluationContext eval_context(state, message.g, false, nullptr);
+        ++worker.evaluated;
+        if (eval_context.is_heuristic_infinite(worker.heuristic)) {
+            info.h = INF;
+            ++worker.dead_ends;
+            return;
+        }
+        info.h = eval_context.get_heuristic_value(worker.heuristic);
+    }
+    ap_float f = info.g + info.h;
+    if (f < incumbent_cost.load())
+        worker.open_list.push({f, info.h, info.g, state.get_id()});
+}
+
+void ParallelEagerSearch::update_incumbent(int worker_id, StateID goal_id, ap_float cost) {
+    lock_guard<mutex> lock(incumbent_mutex);
+    if (cost < incumbent_cost.load()) {
+        incumbent_cost.store(cost);
+        incumbent_worker = worker_id;
+        incumbent_state = goal_id;
+        cout << "Solution with cost " << cost << " found by thread "
+             << worker_id << " [t=" << utils::g_timer << "]" << endl;
+    }
+}
+
+bool ParallelEagerSearch::expand_next_state(
+    int worker_id, vector<const GlobalOperator *> &applicable_ops) {
+    Worker &worker = *workers[worker_id];
+    while (!worker.open_list.empty()) {
+        OpenEntry entry = worker.open_list.top();
+        if (entry.f >= incumbent_cost.load()) {
+            // All remaining states are pruned because the incumbent only gets better.
+            worker.open_list = priority_queue<OpenEntry>();
+            return false;
+        }
+        worker.open_list.pop();
+        GlobalState state = worker.registry.lookup_state(entry.id);
+        const NodeInfo info = worker.node_infos[state];
+        // Skip outdated entries of reopened states.
+        if (entry.g > info.g)
+            continue;
+
+        if (test_goal(state)) {
+            update_incumbent(worker_id, entry.id, info.g);
+            continue;
+        }
+
+        ++worker.expanded;
+        applicable_ops.clear();
+        g_successor_generator->generate_applicable_ops(state, applicable_ops);
+        for (const GlobalOperator *op : applicable_ops) {
+            if (info.real_g + op->get_cost() >= bound)
+                continue;
+            ap_float succ_g = info.g + get_adjusted_cost(*op);
+            if (succ_g >= incumbent_cost.load())
+                continue;
+            ++worker.generated;
+
+            Message *message = worker.get_message();
+            worker.registry.get_successor_values(
+                state, *op, message->values, message->numeric_values);
+            message->g = succ_g;
+            message->real_g = info.real_g + op->get_cost();
+            message->parent_worker = worker_id;
+            message->parent_id = entry.id;
+            message->creating_operator = op;
+            ++worker.sent;
+            send(message);
+        }
+        return true;
+    }
+    return false;
+}
+
+void ParallelEagerSearch::run_worker(int worker_id) {
+    Worker &worker = *workers[worker_id];
+    set_thread_axiom_evaluator(worker.axiom_evaluator.get());
+    vector<const GlobalOperator *> applicable_ops;
+    bool is_busy = true;
+    while (true) {
+        Message *message = worker.inbox.take_all();
+        if (message && !is_busy) {
+            is_busy = true;
+            ++num_busy;
+        }
+        while (message) {
+            Message *next = message->next;
+            receive(worker, *message);
+            // The initial state is the only message not sent by a worker.
+            if (message->parent_worker == -1)
+                delete message;
+            else
+                workers[message->parent_worker]->returned_messages.push(message);
+            --num_busy;
+            message = next;
+        }
+
+        if (expand_next_state(worker_id, applicable_ops))
+            continue;
+
+        if (is_busy) {
+            is_busy = false;
+            --num_busy;
+        }
+        if (num_busy.load() == 0)
+            break;
+        this_thread::yield();
+    }
+    set_thread_axiom_evaluator(nullptr);
+}
+
+void ParallelEagerSearch::extract_plan() {
+    Plan plan;
+    int worker_id = incumbent_worker;
+    StateID id = incumbent_state;
+    while (true) {
+        Worker &worker = *workers[worker_id];
+        const NodeInfo &info = worker.node_infos[worker.registry.lookup_state(id)];
+        if (!info.creating_operator)
+            break;
+        plan.push_back(info.creating_operator);
+        worker_id = info.parent_worker;
+        id = info.parent_id;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+SearchStatus ParallelEagerSearch::step() {
+    // Every worker starts as busy.
+    num_busy += num_threads;
+    vector<thread> threads;
+    for (int i = 0; i < num_threads; ++i)
+        threads.emplace_back(&ParallelEagerSearch::run_worker, this, i);
+    for (thread &t : threads)
+        t.join();
+
+    for (const unique_ptr<Worker> &worker : workers) {
+        statistics.inc_expanded(worker->expanded);
+        statistics.inc_evaluated_states(worker->evaluated);
+        statistics.inc_evaluations(worker->evaluated);
+        statistics.inc_generated(worker->generated);
+        statistics.inc_reopened(worker->reopened);
+        statistics.inc_dead_ends(worker->dead_ends);
+    }
+
+    if (incumbent_worker == -1) {
+        cout << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    cout << "Solution found!" << endl;
+    extract_plan();
+    return SOLVED;
+}
+
+void ParallelEagerSearch::print_statistics() const {
+    for (size_t i = 0; i < workers.size(); ++i) {
+        const Worker &worker = *workers[i];
+        cout << "Thread " << i << ": "
+             << worker.expanded << " expanded, "
+             << worker.evaluated << " evaluated, "
+             << worker.generated << " generated, "
+             << worker.reopened << " reopened, "
+             << worker.sent << " sent, "
+             << worker.registry.size() << " registered" << endl;
+    }
+    statistics.print_detailed_statistics();
+}
+
+static SearchEngine *_parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Hash-distributed A* search",
+        "Parallel A* search that distributes the states among threads by "
+        "their hash values (HDA*). Every thread uses its own instance of "
+        "the heuristic. The search is optimal for admissible heuristics.");
+    parser.add_option<ParseTree>(
+        "heuristic",
+        "heuristic, parsed once for every thread (must not be predefined)");
+    parser.add_option<int>(
+        "threads", "number of threads", "2", Bounds("1", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        // Check that the heuristic can be parsed.
+        OptionParser test_parser(opts.get<ParseTree>("heuristic"), true);
+        test_parser.start_parsing<Heuristic *>();
+        return nullptr;
+    } else {
+        return new ParallelEagerSearch(opts);
+    }
+}
+
+static Plugin<SearchEngine> _plugin("hdastar", _parse);
+}
@@ -0,0 +1,81 @@
+#ifndef SEARCH_ENGINES_PARALLEL_EAGER_SEARCH_H
+#define SEARCH_ENGINES_PARALLEL_EAGER_SEARCH_H
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+#include "../state_id.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace options {
+class Options;
+}
+
+namespace parallel_eager_search {
+struct Message;
+struct Worker;
+
+/*
+  Hash-distributed A* (HDA*, Kishimoto, Fukunaga and Botea, ICAPS 2009).
+
+  Every state is owned by the worker thread selected by the hash value of
+  its (logic and regular numeric) variables. Each worker has its own open
+  list, its own state registry (with its own axiom evaluator) and its own
+  instance of the heuristic, which is parsed anew for every thread. A
+  worker expands its states and sends the successors to their owners
+  through lock-free message queues. The owner detects duplicates,
+  evaluates new states and inserts them into its open list. The threads
+  share no locks except for updating the incumbent solution.
+
+  A goal state only becomes the incumbent solution, and expansions continue
+  until no worker has an open state with an f-value below the cost of the
+  incumbent. Hence, the search is optimal for admissible heuristics.
+
+  Heuristics must not modify shared data during evaluation. Preferred
+  operators are not used.
+*/
+class ParallelEagerSearch : public SearchEngine {
+    const ParseTree heuristic_config;
+    const int num_threads;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Cost of the best solution found so far and where its goal state is stored.
+    std::mutex incumbent_mutex;
+    std::atomic<ap_float> incumbent_cost;
+    int incumbent_worker;
+    StateID incumbent_state;
+
+    /*
+      Number of busy workers plus number of messages in flight. The search
+      terminates when this reaches 0. A worker counts itself as busy before
+      it counts a received message as processed, so the value cannot drop to
+      0 while work is left.
+    */
+    std::atomic<int> num_busy;
+
+    int get_owner(const Message &message) const;
+    void send(Message *message);
+    void receive(Worker &worker, Message &message);
+    bool expand_next_state(int worker_id,
+                           std::vector<const GlobalOperator *> &applicable_ops);
+    void update_incumbent(int worker_id, StateID goal_id, ap_float cost);
+    void run_worker(int worker_id);
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit ParallelEagerSearch(const options::Options &opts);
+    virtual ~ParallelEagerSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
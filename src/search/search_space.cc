@@ -247,6 +247,5 @@ void SearchSpace::dump() const {
 }
 
 void SearchSpace::print_statistics() const {
-    cout << "Number of registered states: "
-         << g_state_registry->size() << endl;
+    g_state_registry->print_statistics();
 }
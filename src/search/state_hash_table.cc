@@ -0,0 +1,103 @@
+#include "state_hash_table.h"
+
+#include "int_packer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+static const size_t INITIAL_NUM_BUCKETS = 1024;
+
+/*
+  The hash values of std::hash are the identity on integers, so the low bits
+  that select the bucket are badly distributed. Mix all bits before using
+  them (this is the finalizer of MurmurHash3).
+*/
+static uint32_t mix(size_t hash) {
+    uint64_t h = hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<uint32_t>(h);
+}
+
+StateHashTable::StateHashTable(const SegmentedArrayVector<PackedStateBin> &state_data_pool_)
+    : state_data_pool(state_data_pool_),
+      buckets(INITIAL_NUM_BUCKETS),
+      num_entries(0),
+      num_lookups(0),
+      num_probes(0),
+      num_state_comparisons(0),
+      max_probe_length(0) {
+}
+
+bool StateHashTable::is_equal(int lhs_id, int rhs_id) const {
+    size_t size = g_state_packer->get_num_bins();
+    const PackedStateBin *lhs_data = state_data_pool[lhs_id];
+    const PackedStateBin *rhs_data = state_data_pool[rhs_id];
+    return equal(lhs_data, lhs_data + size, rhs_data);
+}
+
+void StateHashTable::grow() {
+    vector<Bucket> old_buckets(buckets.size() * 2);
+    old_buckets.swap(buckets);
+    size_t mask = get_mask();
+    for (const Bucket &bucket : old_buckets) {
+        if (bucket.is_empty())
+            continue;
+        size_t pos = bucket.hash & mask;
+        while (!buckets[pos].is_empty())
+            pos = (pos + 1) & mask;
+        buckets[pos] = bucket;
+    }
+}
+
+pair<StateID, bool> StateHashTable::insert(StateID id, size_t hash) {
+    // Keep the load factor at most 3/4.
+    if (4 * (num_entries + 1) > 3 * buckets.size())
+        grow();
+
+    uint32_t short_hash = mix(hash);
+    size_t mask = get_mask();
+    size_t pos = short_hash & mask;
+    int probe_length = 1;
+    ++num_lookups;
+    while (true) {
+        Bucket &bucket = buckets[pos];
+        if (bucket.is_empty()) {
+            bucket.hash = short_hash;
+            bucket.id = id.value;
+            ++num_entries;
+            break;
+        }
+        if (bucket.hash == short_hash) {
+            ++num_state_comparisons;
+            if (is_equal(bucket.id, id.value)) {
+                num_probes += probe_length;
+                max_probe_length = max(max_probe_length, probe_length);
+                return make_pair(StateID(bucket.id), false);
+            }
+        }
+        pos = (pos + 1) & mask;
+        ++probe_length;
+    }
+    num_probes += probe_length;
+    max_probe_length = max(max_probe_length, probe_length);
+    return make_pair(id, true);
+}
+
+void StateHashTable::print_statistics() const {
+    cout << "State hash table buckets: " << buckets.size() << endl;
+    cout << "State hash table load factor: " << get_load_factor() << endl;
+    if (num_lookups > 0) {
+        cout << "State hash table average probe length: "
+             << static_cast<double>(num_probes) / num_lookups << endl;
+        cout << "State hash table state comparisons per lookup: "
+             << static_cast<double>(num_state_comparisons) / num_lookups << endl;
+    }
+    cout << "State hash table maximal probe length: " << max_probe_length << endl;
+}
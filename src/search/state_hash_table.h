@@ -0,0 +1,75 @@
+#ifndef STATE_HASH_TABLE_H
+#define STATE_HASH_TABLE_H
+
+#include "global_state.h"
+#include "segmented_vector.h"
+#include "state_id.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*
+  Open-addressing hash set of StateIDs with linear probing. The StateRegistry
+  can use it instead of std::unordered_set for duplicate detection.
+
+  Every bucket stores the ID of a state together with 32 bits of its hash
+  value (8 bytes in total). A probe only compares the packed state data if
+  the stored hash bits match, so most probes of a lookup do not touch the
+  state data pool at all. The stored hash bits also allow growing the table
+  without hashing any state again.
+
+  The hash value of a state is computed by the caller, who usually has
+  the state data at hand anyway.
+*/
+class StateHashTable {
+    struct Bucket {
+        std::uint32_t hash;
+        int id;
+
+        Bucket() : hash(0), id(-1) {
+        }
+
+        bool is_empty() const {
+            return id == -1;
+        }
+    };
+
+    const SegmentedArrayVector<PackedStateBin> &state_data_pool;
+    std::vector<Bucket> buckets;
+    size_t num_entries;
+
+    // Statistics.
+    long long num_lookups;
+    long long num_probes;
+    long long num_state_comparisons;
+    int max_probe_length;
+
+    size_t get_mask() const {
+        return buckets.size() - 1;
+    }
+
+    bool is_equal(int lhs_id, int rhs_id) const;
+    void grow();
+public:
+    explicit StateHashTable(const SegmentedArrayVector<PackedStateBin> &state_data_pool_);
+
+    /*
+      Inserts the given ID unless a state with the same data is already
+      contained in the table. Returns the ID of the contained state and
+      whether the given ID was inserted.
+    */
+    std::pair<StateID, bool> insert(StateID id, size_t hash);
+
+    size_t size() const {
+        return num_entries;
+    }
+
+    double get_load_factor() const {
+        return static_cast<double>(num_entries) / buckets.size();
+    }
+
+    void print_statistics() const;
+};
+
+#endif
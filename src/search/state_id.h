@@ -8,9 +8,11 @@
 
 class StateID {
     friend class StateRegistry;
+    friend class StateHashTable;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template<typename>
     friend class PerStateInformation;
+    friend class PerStateBitset;
 
     int value;
     explicit StateID(int value_)
@@ -3,20 +3,77 @@
 #include "axioms.h"
 #include "globals.h"
 #include "global_operator.h"
+#include "numeric_encoding.h"
 #include "per_state_information.h"
 #include "../symmetries/graph_creator.h"
+#include "utils/memory.h"
+
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 using namespace std;
 
-StateRegistry::StateRegistry(int number_of_numeric_constants)
-        : state_data_pool(g_state_packer->get_num_bins()),
+static int count_instrumentation_variables() {
+    return count(g_numeric_var_types.begin(), g_numeric_var_types.end(), instrumentation);
+}
+
+/*
+  Zobrist-style state hashing: the hash value of a state is the XOR of the
+  hash values of its bins, and the hash value of a bin depends on its index
+  and content. This allows computing the hash value of a successor from the
+  hash value of its predecessor and the bins that changed.
+*/
+static size_t hash_bin(int bin, PackedStateBin value) {
+    // Finalizer of MurmurHash3 applied to the content offset by the index.
+    uint64_t hash = value + 0x9e3779b97f4a7c15ULL * (bin + 1);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static size_t compute_hash(const PackedStateBin *buffer) {
+    size_t hash = 0;
+    for (int bin = 0; bin < g_state_packer->get_num_bins(); ++bin)
+        hash ^= hash_bin(bin, buffer[bin]);
+    return hash;
+}
+
+StateRegistry::StateRegistry(int number_of_numeric_constants,
+                             AxiomEvaluator *axiom_evaluator)
+        : axiom_evaluator(axiom_evaluator ? axiom_evaluator : g_axiom_evaluator),
+          state_data_pool(g_state_packer->get_num_bins()),
           numeric_constants(vector<ap_float>(number_of_numeric_constants, 0)),
           numeric_indices(vector<int>(g_initial_state_numeric.size(),-1)),
           registered_states(0,
-                            StateIDSemanticHash(state_data_pool),
+                            StateIDSemanticHash(state_hashes),
                             StateIDSemanticEqual(state_data_pool)),
+          num_instrumentation_variables(count_instrumentation_variables()),
+          // The arena cannot have a stride of 0, but stays empty in that case.
+          instrumentation_data(max(num_instrumentation_variables, 1)),
+          num_generated_successors(0),
+          bin_is_changed(g_state_packer->get_num_bins(), false),
+          num_incremental_hashes(0),
+          num_canonical_cache_lookups(0),
+          num_canonical_cache_hits(0),
           cached_initial_state(0) {
+    for (size_t var = 0; var < g_variable_domain.size(); ++var) {
+        if (g_axiom_layers[var] != -1)
+            bin_is_changed[g_state_packer->get_bin_index(var)] = true;
+    }
+    for (const ComparisonAxiom &axiom : g_comp_axioms)
+        bin_is_changed[g_state_packer->get_bin_index(axiom.affected_variable)] = true;
+    for (int bin = 0; bin < g_state_packer->get_num_bins(); ++bin) {
+        if (bin_is_changed[bin]) {
+            derived_bins.push_back(bin);
+            bin_is_changed[bin] = false;
+        }
+    }
+    if (g_use_open_addressing)
+        use_open_addressing();
 }
 
 
@@ -28,23 +85,46 @@ StateRegistry::~StateRegistry() {
     delete cached_initial_state;
 }
 
-StateID StateRegistry::insert_id_or_pop_state() {
+StateID StateRegistry::insert_id_or_pop_state(size_t hash) {
     /*
       Attempt to insert a StateID for the last state of state_data_pool
       if none is present yet. If this fails (another entry for this state
       is present), we have to remove the duplicate entry from the
-      state data pool.
+      state data pool. The given hash value must be the one computed by
+      compute_hash for the last state.
     */
     StateID id(state_data_pool.size() - 1);
+    assert(hash == compute_hash(state_data_pool[id.value]));
+    state_hashes.push_back(hash);
+    if (open_addressing_states) {
+        pair<StateID, bool> result = open_addressing_states->insert(id, hash);
+        if (!result.second) {
+            state_data_pool.pop_back();
+            state_hashes.pop_back();
+        }
+        assert(open_addressing_states->size() == state_data_pool.size());
+        return result.first;
+    }
     pair<StateIDSet::iterator, bool> result = registered_states.insert(id);
     bool is_new_entry = result.second;
     if (!is_new_entry) {
         state_data_pool.pop_back();
+        state_hashes.pop_back();
     }
     assert(registered_states.size() == state_data_pool.size());
     return *result.first;
 }
 
+void StateRegistry::use_open_addressing() {
+    if (open_addressing_states)
+        return;
+    open_addressing_states = utils::make_unique_ptr<StateHashTable>(state_data_pool);
+    for (size_t i = 0; i < state_data_pool.size(); ++i)
+        open_addressing_states->insert(StateID(i), state_hashes[i]);
+    registered_states.clear();
+    registered_states.rehash(0);
+}
+
 GlobalState StateRegistry::lookup_state(StateID id) const {
     return GlobalState(state_data_pool[id.value], *this, id);
 }
@@ -92,10 +172,9 @@ const GlobalState &StateRegistry::get_initial_state() {
                 case regular:
                     // only regular variables are stored within the state buffer
                     assert(numeric_indices[i] == -1);
-                    numeric_indices[i] = regular_index;
-//        		if(DEBUG) cout << "regular variable numeric_indices[" << i << "] is " << regular_index << " name: " <<g_numeric_var_names[i] <<endl;
-                    //        	cout << "D->ULL " << g_initial_state_numeric[i] << " -> "<< reinterpretedDouble;// << endl;
-                    g_state_packer->set(buffer, regular_index++, g_state_packer->packDouble(g_initial_state_numeric[i]));
+                    numeric_indices[i] = regular_index++;
+//        		if(DEBUG) cout << "regular variable numeric_indices[" << i << "] is " << numeric_indices[i] << " name: " <<g_numeric_var_names[i] <<endl;
+                    set_numeric_value(buffer, i, g_initial_state_numeric[i]);
                     break;
                 default:
                     assert(false);
@@ -109,14 +188,14 @@ const GlobalState &StateRegistry::get_initial_state() {
                         << regular_index - g_initial_state_data.size() << " regular numeric variables " << endl;
 //        if (DEBUG) cout << "Constants = " << numeric_constants << endl;
 //        if (DEBUG) cout << "InstrVars = " << instrumentation_variables << endl;
-        g_axiom_evaluator->evaluate_arithmetic_axioms(g_initial_state_numeric);
-        g_axiom_evaluator->evaluate(buffer, g_initial_state_numeric); // evaluate logic axioms
+        axiom_evaluator->evaluate_arithmetic_axioms(g_initial_state_numeric);
+        axiom_evaluator->evaluate(buffer, g_initial_state_numeric); // evaluate logic axioms
         state_data_pool.push_back(buffer);
         // buffer is copied by push_back
+        StateID id = insert_id_or_pop_state(compute_hash(buffer));
         delete[] buffer;
-        StateID id = insert_id_or_pop_state();
         cached_initial_state = new GlobalState(lookup_state(id));
-        g_cost_information[*cached_initial_state] = instrumentation_variables; // save instrumentation variables in PerStateInformation attachment
+        set_instrumentation_values(id, instrumentation_variables);
 
         // reset the initial state with updated axioms
         // set g_initial_state_numeric to the state with evaluated axioms:
@@ -134,7 +213,7 @@ void StateRegistry::get_numeric_successor(
         std::vector<ap_float>& predecessor_vals,
         std::vector<ap_float>& metric_part,
         const GlobalOperator &op) {
-    auto value_before_change = predecessor_vals;
+    value_before_change.assign(predecessor_vals.begin(), predecessor_vals.end());
 
     for (const auto & ass_eff : op.get_assign_effects()) {
         assert((int) predecessor_vals.size() > ass_eff.aff_var);
@@ -170,7 +249,7 @@ void StateRegistry::get_numeric_successor(
         }
     }
 
-    g_axiom_evaluator->evaluate_arithmetic_axioms(predecessor_vals);
+    axiom_evaluator->evaluate_arithmetic_axioms(predecessor_vals);
 }
 
 void StateRegistry::get_numeric_successor(
@@ -182,6 +261,7 @@ void StateRegistry::get_numeric_successor(
     assert(buffer);
     assert(previous_buffer);
 
+    changed_numeric_vars.clear();
     for (const auto & ass_eff : op.get_assign_effects()) {
         assert((int) predecessor_vals.size() > ass_eff.aff_var);
         assert((int) predecessor_vals.size() > ass_eff.ass_var);
@@ -191,11 +271,13 @@ void StateRegistry::get_numeric_successor(
         ap_float ass_val = predecessor_vals[ass_eff.ass_var];
 
         if (g_numeric_var_types[ass_eff.ass_var] == regular)
-            ass_val = g_state_packer->getDouble(previous_buffer, numeric_indices[ass_eff.ass_var]);
+            ass_val = get_numeric_value(previous_buffer, ass_eff.ass_var);
 
         ap_float result = assign_effect(predecessor_vals[ass_eff.aff_var],
                                         ass_eff.fop,
                                         ass_val);
+        if (result != predecessor_vals[ass_eff.aff_var])
+            changed_numeric_vars.push_back(ass_eff.aff_var);
         //		if (DEBUG) cout << predecessor_vals[ass_eff.aff_var] << ass_eff.fop << predecessor_vals[ass_eff.ass_var] << " -> " << result << endl;
 
         switch (g_numeric_var_types[ass_eff.aff_var]) {
@@ -209,7 +291,7 @@ void StateRegistry::get_numeric_successor(
                 break;
             case regular:
                 //    		cout << "state registry successor debug: " << "affvar = " << ass_eff.aff_var << " numeric index = " << numeric_indices[ass_eff.aff_var] << endl;
-                g_state_packer->setDouble(buffer, numeric_indices[ass_eff.aff_var], result);
+                set_numeric_value(buffer, ass_eff.aff_var, result);
 //				cout << "wrote result " << result << "  to buffer" << endl;
                 predecessor_vals[ass_eff.aff_var] = result;
                 break;
@@ -219,8 +301,11 @@ void StateRegistry::get_numeric_successor(
         }
     }
 
-    g_axiom_evaluator->evaluate_arithmetic_axioms(predecessor_vals);
-    g_axiom_evaluator->evaluate(buffer, predecessor_vals); // evaluate logic + comparison axioms
+    // The buffer is a copy of the predecessor, so only axioms depending on
+    // variables changed by the operator have to be re-evaluated.
+    axiom_evaluator->evaluate_incrementally(buffer, predecessor_vals,
+                                              changed_numeric_vars,
+                                              changed_logic_vars);
 }
 
 void StateRegistry::get_canonical_numeric_successor(
@@ -230,6 +315,16 @@ void StateRegistry::get_canonical_numeric_successor(
         PackedStateBin *buffer,
         const PackedStateBin *previous_buffer) {
     assert(g_symmetry_graph != nullptr);
+    apply_assign_effects(predecessor_vals, metric_part, op, buffer, previous_buffer);
+    canonicalize(predecessor_vals, buffer);
+}
+
+void StateRegistry::apply_assign_effects(
+        std::vector<ap_float>& predecessor_vals,
+        std::vector<ap_float>& metric_part,
+        const GlobalOperator &op,
+        PackedStateBin *buffer,
+        const PackedStateBin *previous_buffer) {
     assert(buffer);
     assert(previous_buffer);
 
@@ -242,7 +337,7 @@ void StateRegistry::get_canonical_numeric_successor(
         ap_float ass_val = predecessor_vals[ass_eff.ass_var];
 
         if (g_numeric_var_types[ass_eff.ass_var] == regular)
-            ass_val = g_state_packer->getDouble(previous_buffer, numeric_indices[ass_eff.ass_var]);
+            ass_val = get_numeric_value(previous_buffer, ass_eff.ass_var);
 
         ap_float result = assign_effect(predecessor_vals[ass_eff.aff_var],ass_eff.fop, ass_val);
         //		if (DEBUG) cout << predecessor_vals[ass_eff.aff_var] << ass_eff.fop << predecessor_vals[ass_eff.ass_var] << " -> " << result << endl;
@@ -259,7 +354,7 @@ void StateRegistry::get_canonical_numeric_successor(
             case regular:
                 //    		cout << "state registry successor debug: " << "affvar = " << ass_eff.aff_var << " numeric index = " << numeric_indices[ass_eff.aff_var] << endl;
                 if (buffer) {
-                    g_state_packer->setDouble(buffer, numeric_indices[ass_eff.aff_var], result);
+                    set_numeric_value(buffer, ass_eff.aff_var, result);
 //				cout << "wrote result " << result << "  to buffer" << endl;
                 }
                 predecessor_vals[ass_eff.aff_var] = result;
@@ -270,17 +365,20 @@ void StateRegistry::get_canonical_numeric_successor(
         }
     }
 
-    bool changed = g_symmetry_graph->to_canonical_state(buffer, predecessor_vals);
+}
+
+void StateRegistry::canonicalize(vector<ap_float> &predecessor_vals, PackedStateBin *buffer) {
+    bool changed = g_symmetry_graph->to_canonical_state(buffer, canonical_values, predecessor_vals);
     if (changed && buffer) {
         for (size_t i = 0; i < predecessor_vals.size(); ++i) {
             if (g_numeric_var_types[i] == regular) {
-                g_state_packer->setDouble(buffer, numeric_indices[i], predecessor_vals[i]);
+                set_numeric_value(buffer, i, predecessor_vals[i]);
             }
         }
     }
 
-    g_axiom_evaluator->evaluate_arithmetic_axioms(predecessor_vals);
-    g_axiom_evaluator->evaluate(buffer, predecessor_vals); // evaluate logic + comparison axioms
+    axiom_evaluator->evaluate_arithmetic_axioms(predecessor_vals);
+    axiom_evaluator->evaluate(buffer, predecessor_vals); // evaluate logic + comparison axioms
 }
 
 //TODO it would be nice to move the actual state creation (and operator application)
@@ -290,45 +388,32 @@ GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, c
     assert(!op.is_axiom());
     state_data_pool.push_back(predecessor.get_packed_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
+    changed_logic_vars.clear();
     for (size_t i = 0; i < op.get_effects().size(); ++i) {
         const GlobalEffect &effect = op.get_effects()[i];
-        if (effect.does_fire(predecessor))
+        if (effect.does_fire(predecessor)) {
+            if (predecessor[effect.var] != effect.val)
+                changed_logic_vars.push_back(effect.var);
             g_state_packer->set(buffer, effect.var, effect.val);
+        }
     }
 //    if (DEBUG) cout << "Determining Successor state. getting predecessor..." << endl;
-    vector<ap_float> succ_vals = get_numeric_vars(predecessor);
-    vector<ap_float> inst_vals = g_cost_information[predecessor];
-//    if (DEBUG) cout << "Predecessor vector = " << succ_vals << endl;
-//    if (DEBUG) cout << "Instrumentation vector = " << inst_vals << endl;
-    get_numeric_successor(succ_vals, inst_vals, op, buffer, predecessor.get_packed_buffer());
-//    if (DEBUG) cout << "Successor vector = " << succ_vals << endl;
-//    if (DEBUG) cout << "Instrumentation vector = " << inst_vals << endl;
-    StateID id = insert_id_or_pop_state();
+    load_successor_buffers(predecessor);
+    // Only needed to resolve duplicates when maximizing, see below.
+    ap_float predecessor_metric = g_metric_minimizes ? 0 : evaluate_metric(successor_numeric_values);
+    get_numeric_successor(successor_numeric_values, successor_metric_part, op, buffer, predecessor.get_packed_buffer());
+    StateID id = insert_id_or_pop_state(compute_successor_hash(predecessor, op, buffer));
     GlobalState successor = lookup_state(id);
-    if (id.value == (int) state_data_pool.size()-1) {
-//    	if(DEBUG) cout << "New State!!!!" << endl;
-        g_cost_information[successor] = inst_vals;
-    } else {
-        vector<ap_float> old_metric = g_cost_information[successor];
-        ap_float old_val = evaluate_metric(get_numeric_vars(predecessor));
-        ap_float new_val = evaluate_metric(succ_vals);
-//    	if (DEBUG) cout << "Metric of old state = " << old_val << " new = " << new_val << endl;
-        if (g_metric_minimizes && old_val < new_val) {
-            g_cost_information[successor] = old_metric;
-//    			cout << "metric minimizes, so the old metric value retains : " << evaluate_metric(successor);
-        } else {
-            g_cost_information[successor] = inst_vals;
-//    		cout << "metric maximizes or oldval > newval" << endl;
-        }
-
-        if (!g_metric_minimizes && old_val > new_val) {
-            g_cost_information[successor] = old_metric;
-//    		cout << "metric maximizes, so the old metric value retains : " << evaluate_metric(successor);
-        } else {
-            g_cost_information[successor] = inst_vals;
-            //    	else cout << "metric minimizes or oldval < newval" << endl;
-        }
+    bool is_new_state = id.value == (int) state_data_pool.size() - 1;
+    /*
+      For duplicates, the metric value of the old state only survives if the
+      metric is maximized and the old value is larger.
+    */
+    if (is_new_state || g_metric_minimizes ||
+        predecessor_metric <= evaluate_metric(successor_numeric_values)) {
+        set_instrumentation_values(id, successor_metric_part);
     }
+    ++num_generated_successors;
 //    if (DEBUG) {
 //    	cout << "State registry returns successor of " << predecessor.id << " : " << id << " (Operator =" << op.get_name() << ")" << endl;
 //    	successor.dump_fdr();
@@ -347,39 +432,59 @@ GlobalState StateRegistry::get_canonical_successor_state(const GlobalState &pred
             g_state_packer->set(buffer, effect.var, effect.val);
     }
 //    if (DEBUG) cout << "Determining Successor state. getting predecessor..." << endl;
-    vector<ap_float> succ_vals = get_numeric_vars(predecessor);
-    vector<ap_float> inst_vals = g_cost_information[predecessor];
-//    if (DEBUG) cout << "Predecessor vector = " << succ_vals << endl;
-//    if (DEBUG) cout << "Instrumentation vector = " << inst_vals << endl;
-    get_canonical_numeric_successor(succ_vals, inst_vals, op, buffer, predecessor.get_packed_buffer());
-//    if (DEBUG) cout << "Successor vector = " << succ_vals << endl;
-//    if (DEBUG) cout << "Instrumentation vector = " << inst_vals << endl;
-    StateID id = insert_id_or_pop_state();
-    GlobalState successor = lookup_state(id);
-    if (id.value == (int) state_data_pool.size()-1) {
-//    	if(DEBUG) cout << "New State!!!!" << endl;
-        g_cost_information[successor] = inst_vals;
-    } else {
-        vector<ap_float> old_metric = g_cost_information[successor];
-        ap_float old_val = evaluate_metric(get_numeric_vars(predecessor));
-        ap_float new_val = evaluate_metric(succ_vals);
-//    	if (DEBUG) cout << "Metric of old state = " << old_val << " new = " << new_val << endl;
-        if (g_metric_minimizes && old_val < new_val) {
-            g_cost_information[successor] = old_metric;
-//    			cout << "metric minimizes, so the old metric value retains : " << evaluate_metric(successor);
-        } else {
-            g_cost_information[successor] = inst_vals;
-//    		cout << "metric maximizes or oldval > newval" << endl;
-        }
+    load_successor_buffers(predecessor);
+    // Only needed to resolve duplicates when maximizing, see below.
+    ap_float predecessor_metric = g_metric_minimizes ? 0 : evaluate_metric(successor_numeric_values);
+    apply_assign_effects(successor_numeric_values, successor_metric_part, op, buffer, predecessor.get_packed_buffer());
 
-        if (!g_metric_minimizes && old_val > new_val) {
-            g_cost_information[successor] = old_metric;
-//    		cout << "metric maximizes, so the old metric value retains : " << evaluate_metric(successor);
+    /*
+      The canonical state only depends on the state data, so it can be
+      looked up in the cache. When maximizing, the metric value of the
+      canonical state is needed below, so we canonicalize in any case.
+    */
+    int num_bins = g_state_packer->get_num_bins();
+    if (canonical_cache_ids.empty() && g_metric_minimizes) {
+        size_t cache_size = g_symmetry_graph->get_canonical_cache_size();
+        canonical_cache_hashes.resize(cache_size);
+        canonical_cache_states.resize(cache_size * num_bins);
+        canonical_cache_ids.resize(cache_size, StateID::no_state);
+    }
+    StateID id = StateID::no_state;
+    StateID *cached_id = nullptr;
+    if (!canonical_cache_ids.empty()) {
+        size_t hash = compute_hash(buffer);
+        size_t slot = hash % canonical_cache_ids.size();
+        PackedStateBin *cached_state = &canonical_cache_states[slot * num_bins];
+        cached_id = &canonical_cache_ids[slot];
+        ++num_canonical_cache_lookups;
+        if (*cached_id != StateID::no_state && canonical_cache_hashes[slot] == hash &&
+            equal(buffer, buffer + num_bins, cached_state)) {
+            ++num_canonical_cache_hits;
+            id = *cached_id;
+            state_data_pool.pop_back();
         } else {
-            g_cost_information[successor] = inst_vals;
-            //    	else cout << "metric minimizes or oldval < newval" << endl;
+            canonical_cache_hashes[slot] = hash;
+            copy(buffer, buffer + num_bins, cached_state);
         }
     }
+    if (id == StateID::no_state) {
+        canonicalize(successor_numeric_values, buffer);
+        // Canonicalization can permute the whole state, so hash it from scratch.
+        id = insert_id_or_pop_state(compute_hash(buffer));
+        if (cached_id)
+            *cached_id = id;
+    }
+    GlobalState successor = lookup_state(id);
+    bool is_new_state = id.value == (int) state_data_pool.size() - 1;
+    /*
+      For duplicates, the metric value of the old state only survives if the
+      metric is maximized and the old value is larger.
+    */
+    if (is_new_state || g_metric_minimizes ||
+        predecessor_metric <= evaluate_metric(successor_numeric_values)) {
+        set_instrumentation_values(id, successor_metric_part);
+    }
+    ++num_generated_successors;
 //    if (DEBUG) {
 //    	cout << "State registry returns successor of " << predecessor.id << " : " << id << " (Operator =" << op.get_name() << ")" << endl;
 //    	successor.dump_fdr();
@@ -387,10 +492,31 @@ GlobalState StateRegistry::get_canonical_successor_state(const GlobalState &pred
     return successor;
 }
 
+void StateRegistry::get_successor_values(const GlobalState &predecessor,
+                                         const GlobalOperator &op,
+                                         vector<container_int> &values,
+                                         vector<ap_float> &numeric_values) {
+    assert(!op.is_axiom());
+    values.resize(g_variable_domain.size());
+    for (size_t var = 0; var < values.size(); ++var)
+        values[var] = predecessor[var];
+    for (const GlobalEffect &effect : op.get_effects()) {
+        if (effect.does_fire(predecessor))
+            values[effect.var] = effect.val;
+    }
+    get_numeric_vars(predecessor, numeric_values);
+    if (num_instrumentation_variables > 0) {
+        const ap_float *instrumentation_values = get_instrumentation_values(predecessor.get_id());
+        successor_metric_part.assign(instrumentation_values,
+                                     instrumentation_values + num_instrumentation_variables);
+    }
+    get_numeric_successor(numeric_values, successor_metric_part, op);
+}
+
 GlobalState StateRegistry::register_state(const std::vector<container_int> &values, std::vector<ap_float> &numeric_values) {
-    PackedStateBin *buffer = new PackedStateBin[g_state_packer->get_num_bins()];
     // Avoid garbage values in half-full bins.
-    fill_n(buffer, g_state_packer->get_num_bins(), 0);
+    registered_buffer.assign(g_state_packer->get_num_bins(), 0);
+    PackedStateBin *buffer = registered_buffer.data();
     for (size_t i = 0; i < values.size(); ++i) {
         g_state_packer->set(buffer, i, values[i]);
     }
@@ -398,19 +524,19 @@ GlobalState StateRegistry::register_state(const std::vector<container_int> &valu
     int constant_index = 0;
     int derived_index = 0;
 //    int instrumentation_index = 0;
-    vector<ap_float> instrumentation_variables = vector<ap_float>();
-    assert(instrumentation_variables.empty());
+    vector<ap_float> &instrumentation_variables = registered_metric_part;
+    instrumentation_variables.clear();
     for (size_t i = 0; i < numeric_values.size(); ++i) {
         switch (g_numeric_var_types[i]) {
             case instrumentation:
                 // instrumentation variables are stored in a PerStateInformation attachment
-                assert(numeric_indices[i] == -1);
+                assert(numeric_indices[i] == -1 ||
+                       numeric_indices[i] == (int) instrumentation_variables.size());
                 numeric_indices[i] = instrumentation_variables.size();
                 instrumentation_variables.push_back(numeric_values[i]);
                 break;
             case constant:
-                // constants are stored only once
-                assert(numeric_indices[i] == -1);
+                // constants are stored only once (by get_initial_state)
                 break;
             case unknown:
                 assert(false);
@@ -421,9 +547,9 @@ GlobalState StateRegistry::register_state(const std::vector<container_int> &valu
                 break;
             case regular:
                 // only regular variables are stored within the state buffer
-                assert(numeric_indices[i] == -1);
-                numeric_indices[i] = regular_index;
-                g_state_packer->set(buffer, regular_index++, g_state_packer->packDouble(numeric_values[i]));
+                assert(numeric_indices[i] == -1 || numeric_indices[i] == regular_index);
+                numeric_indices[i] = regular_index++;
+                set_numeric_value(buffer, i, numeric_values[i]);
                 break;
             default:
                 cerr << "Unexpected numeric variable type: " << g_numeric_var_types[i] << endl
@@ -431,40 +557,160 @@ GlobalState StateRegistry::register_state(const std::vector<container_int> &valu
                 utils::exit_with(utils::ExitCode::CRITICAL_ERROR);
         }
     }
-    g_axiom_evaluator->evaluate_arithmetic_axioms(numeric_values);
-    g_axiom_evaluator->evaluate(buffer, numeric_values); // evaluate logic axioms
+    axiom_evaluator->evaluate_arithmetic_axioms(numeric_values);
+    axiom_evaluator->evaluate(buffer, numeric_values); // evaluate logic axioms
     state_data_pool.push_back(buffer);
     // buffer is copied by push_back
-    delete[] buffer;
-    StateID id = insert_id_or_pop_state();
+    StateID id = insert_id_or_pop_state(compute_hash(buffer));
     GlobalState new_state = lookup_state(id);
 
-    if (id.value == (int) state_data_pool.size()-1) {
-//    	if(DEBUG) cout << "New State!!!!" << endl;
-        g_cost_information[new_state] = instrumentation_variables;
-    } else {
-        vector<ap_float> old_metric = g_cost_information[new_state];
-        ap_float old_val = evaluate_metric(get_numeric_vars(new_state));
-        ap_float new_val = evaluate_metric(numeric_values);
-//    	if (DEBUG) cout << "Metric of old state = " << old_val << " new = " << new_val << endl;
-        if (g_metric_minimizes && old_val < new_val) {
-            g_cost_information[new_state] = old_metric;
-//    			cout << "metric minimizes, so the old metric value retains : " << evaluate_metric(successor);
+    bool is_new_state = id.value == (int) state_data_pool.size() - 1;
+    if (is_new_state || g_metric_minimizes ||
+        evaluate_metric(get_numeric_vars(new_state)) <= evaluate_metric(numeric_values)) {
+        set_instrumentation_values(id, instrumentation_variables);
+    }
+
+    return new_state;
+}
+
+ap_float StateRegistry::get_numeric_value(const PackedStateBin *buffer, int var) const {
+    assert(g_numeric_var_types[var] == regular);
+    container_int code = g_state_packer->get(buffer, numeric_indices[var]);
+    switch (g_numeric_encoding->get_type(var)) {
+    case NumericEncoding::FINITE:
+        return g_numeric_encoding->decode_finite(code);
+    case NumericEncoding::INTEGER:
+        if (code & NumericEncoding::INTEGER_ESCAPE_BIT)
+            return numeric_dictionary[code & ~NumericEncoding::INTEGER_ESCAPE_BIT];
+        return static_cast<ap_float>(static_cast<long long>(code) -
+                                     static_cast<long long>(NumericEncoding::INTEGER_OFFSET));
+    case NumericEncoding::DICTIONARY:
+        return numeric_dictionary[code];
+    default:
+        return g_state_packer->unpackDouble(code);
+    }
+}
+
+void StateRegistry::set_numeric_value(PackedStateBin *buffer, int var, ap_float value) {
+    assert(g_numeric_var_types[var] == regular);
+    container_int code;
+    switch (g_numeric_encoding->get_type(var)) {
+    case NumericEncoding::FINITE:
+        code = g_numeric_encoding->encode_finite(value);
+        break;
+    case NumericEncoding::INTEGER:
+        if (NumericEncoding::is_small_integer(value)) {
+            code = static_cast<container_int>(static_cast<long long>(value) +
+                                              static_cast<long long>(NumericEncoding::INTEGER_OFFSET));
         } else {
-            g_cost_information[new_state] = instrumentation_variables;
-//    		cout << "metric maximizes or oldval > newval" << endl;
+            code = get_dictionary_id(value);
+            if (code >= NumericEncoding::INTEGER_ESCAPE_BIT) {
+                cerr << "Numeric value dictionary exhausted." << endl;
+                utils::exit_with(utils::ExitCode::OUT_OF_MEMORY);
+            }
+            code |= NumericEncoding::INTEGER_ESCAPE_BIT;
         }
+        break;
+    case NumericEncoding::DICTIONARY:
+        code = get_dictionary_id(value);
+        break;
+    default:
+        code = g_state_packer->packDouble(value);
+        break;
+    }
+    g_state_packer->set(buffer, numeric_indices[var], code);
+}
 
-        if (!g_metric_minimizes && old_val > new_val) {
-            g_cost_information[new_state] = old_metric;
-//    		cout << "metric maximizes, so the old metric value retains : " << evaluate_metric(successor);
-        } else {
-            g_cost_information[new_state] = instrumentation_variables;
-            //    	else cout << "metric minimizes or oldval < newval" << endl;
+container_int StateRegistry::get_dictionary_id(ap_float value) {
+    // Key by bit pattern so that the dictionary is exact (e.g. for NaN).
+    auto result = numeric_dictionary_ids.insert(
+        make_pair(g_state_packer->packDouble(value), numeric_dictionary.size()));
+    if (result.second) {
+        if (numeric_dictionary.size() == NumericEncoding::DICTIONARY_RANGE) {
+            cerr << "Numeric value dictionary exhausted." << endl;
+            utils::exit_with(utils::ExitCode::OUT_OF_MEMORY);
         }
+        numeric_dictionary.push_back(value);
     }
+    return result.first->second;
+}
 
-    return new_state;
+size_t StateRegistry::compute_successor_hash(const GlobalState &predecessor,
+                                             const GlobalOperator &op,
+                                             const PackedStateBin *buffer) {
+    const PackedStateBin *predecessor_buffer = predecessor.get_packed_buffer();
+    /*
+      Only bins written by the effects of op and bins of derived variables
+      can differ between predecessor and successor.
+    */
+    auto check_bin = [&](int bin) {
+        if (!bin_is_changed[bin] && buffer[bin] != predecessor_buffer[bin]) {
+            bin_is_changed[bin] = true;
+            changed_bins.push_back(bin);
+        }
+    };
+    changed_bins.clear();
+    for (const GlobalEffect &effect : op.get_effects())
+        check_bin(g_state_packer->get_bin_index(effect.var));
+    for (const AssignEffect &effect : op.get_assign_effects()) {
+        if (g_numeric_var_types[effect.aff_var] == regular)
+            check_bin(g_state_packer->get_bin_index(numeric_indices[effect.aff_var]));
+    }
+    for (int bin : derived_bins)
+        check_bin(bin);
+    for (int bin : changed_bins)
+        bin_is_changed[bin] = false;
+
+    /*
+      Updating the hash value costs two bin hashes per changed bin. If
+      axioms changed many derived variables, rehashing is cheaper.
+    */
+    if (2 * changed_bins.size() > static_cast<size_t>(g_state_packer->get_num_bins()))
+        return compute_hash(buffer);
+    ++num_incremental_hashes;
+    size_t hash = state_hashes[predecessor.get_id().value];
+    for (int bin : changed_bins)
+        hash ^= hash_bin(bin, predecessor_buffer[bin]) ^ hash_bin(bin, buffer[bin]);
+    return hash;
+}
+
+void StateRegistry::load_successor_buffers(const GlobalState &predecessor) {
+    get_numeric_vars(predecessor, successor_numeric_values);
+    if (num_instrumentation_variables > 0) {
+        const ap_float *values = get_instrumentation_values(predecessor.get_id());
+        successor_metric_part.assign(values, values + num_instrumentation_variables);
+    }
+}
+
+void StateRegistry::set_instrumentation_values(StateID id, const vector<ap_float> &values) {
+    if (num_instrumentation_variables == 0)
+        return;
+    assert((int) values.size() == num_instrumentation_variables);
+    if (id.value == (int) instrumentation_data.size()) {
+        instrumentation_data.push_back(values.data());
+    } else {
+        assert(id.value < (int) instrumentation_data.size());
+        copy(values.begin(), values.end(), instrumentation_data[id.value]);
+    }
+}
+
+void StateRegistry::print_statistics() const {
+    cout << "Number of registered states: " << size() << endl;
+    if (open_addressing_states)
+        open_addressing_states->print_statistics();
+    cout << "Bytes per state: "
+         << g_state_packer->get_num_bins() * g_state_packer->get_bin_size_in_bytes()
+         << endl;
+    cout << "Numeric value dictionary entries: " << numeric_dictionary.size() << endl;
+    cout << "Instrumentation bytes per state: "
+         << num_instrumentation_variables * sizeof(ap_float) << endl;
+    cout << "Incrementally hashed successors: " << num_incremental_hashes
+         << " of " << num_generated_successors << endl;
+    if (num_canonical_cache_lookups > 0) {
+        cout << "Canonical state cache hits: " << num_canonical_cache_hits
+             << " of " << num_canonical_cache_lookups << endl;
+    }
+    axiom_evaluator->print_statistics();
 }
 
 void StateRegistry::subscribe(PerStateInformationBase *psi) const {
@@ -509,10 +755,16 @@ ap_float StateRegistry::assign_effect(ap_float aff_value, f_operator fop, ap_flo
 }
 
 vector<ap_float> StateRegistry::get_numeric_vars(const GlobalState &state) const {
-    vector<ap_float> result(g_numeric_var_types.size());
+    vector<ap_float> result;
+    get_numeric_vars(state, result);
+    return result;
+}
+
+void StateRegistry::get_numeric_vars(const GlobalState &state, vector<ap_float> &result) const {
+    result.resize(g_numeric_var_types.size());
 //	if(DEBUG) cout << "Retrieving numeric state variables from StateRegistry" <<endl;
-    const vector<ap_float> &instrumentation_variables = g_cost_information[state];
-//    if(DEBUG) cout << "instrumentation variables " << instrumentation_variables << endl;
+    const ap_float *instrumentation_variables = num_instrumentation_variables > 0 ?
+        get_instrumentation_values(state.get_id()) : nullptr;
     assert(g_initial_state_numeric.size() == g_numeric_var_types.size());
     assert(g_initial_state_numeric.size() == numeric_indices.size());
     const PackedStateBin *buffer = state.get_packed_buffer();
@@ -522,7 +774,7 @@ vector<ap_float> StateRegistry::get_numeric_vars(const GlobalState &state) const
             case instrumentation:
 //    		if (DEBUG) cout << "instrumentation_variables.size()" << instrumentation_variables.size()
 //    				<< "numeric_indices["<<i<<"] " << numeric_indices[i]<< endl;
-                assert((int) instrumentation_variables.size() > numeric_indices[i]);
+                assert(num_instrumentation_variables > numeric_indices[i]);
                 result[i] = instrumentation_variables[numeric_indices[i]];
                 break;
             case constant:
@@ -537,8 +789,7 @@ vector<ap_float> StateRegistry::get_numeric_vars(const GlobalState &state) const
                 break;
             case regular:
 //    		if (DEBUG) cout << "variable #" << i << " has buffer index " << numeric_indices[i] << endl;
-//    		cout << "unpacked double is " << g_state_packer->getDouble(buffer, numeric_indices[i]) << endl;
-                result[i] = g_state_packer->getDouble(buffer, numeric_indices[i]);
+                result[i] = get_numeric_value(buffer, i);
                 break;
             default:
                 cerr << "Unexpected numeric variable type: " << g_numeric_var_types[i] << endl
@@ -550,8 +801,7 @@ vector<ap_float> StateRegistry::get_numeric_vars(const GlobalState &state) const
 //    if (DEBUG) cout << "numeric vars before evaluating axioms\n"<< result << endl;
     if(has_numeric_axioms()) {
 //    	if (DEBUG) cout << "evaluating numeric axioms..." << endl;
-        g_axiom_evaluator->evaluate_arithmetic_axioms(result);
+        axiom_evaluator->evaluate_arithmetic_axioms(result);
     }
 //    if (DEBUG) cout << "numeric vars after evaluating axioms\n"<< result << endl;
-    return result;
 }
@@ -5,11 +5,14 @@
 #include "globals.h"
 #include "int_packer.h"
 #include "segmented_vector.h"
+#include "state_hash_table.h"
 #include "state_id.h"
 
 #include "utils/hash.h"
 
+#include <memory>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 
 /*
@@ -97,17 +100,21 @@
     to store for each state and each landmark whether it was reached in this state.
 */
 
+class AxiomEvaluator;
 class PerStateInformationBase;
 
 class StateRegistry {
+    /*
+      The hash values of all registered states are stored in state_hashes
+      (see compute_hash), so hashing a StateID is a lookup.
+    */
     struct StateIDSemanticHash {
-        const SegmentedArrayVector<PackedStateBin> &state_data_pool;
-        StateIDSemanticHash(const SegmentedArrayVector<PackedStateBin> &state_data_pool_)
-            : state_data_pool(state_data_pool_) {
+        const SegmentedVector<size_t> &state_hashes;
+        StateIDSemanticHash(const SegmentedVector<size_t> &state_hashes_)
+            : state_hashes(state_hashes_) {
         }
         size_t operator()(StateID id) const {
-            return utils::hash_sequence(state_data_pool[id.value],
-                                        g_state_packer->get_num_bins());
+            return state_hashes[id.value];
         }
     };
 
@@ -134,18 +141,100 @@ class StateRegistry {
                                StateIDSemanticHash,
                                StateIDSemanticEqual> StateIDSet;
 
+    /*
+      The axiom evaluator has scratch data, so registries that are used in
+      different threads need their own evaluators. By default, this is
+      g_axiom_evaluator.
+    */
+    AxiomEvaluator *axiom_evaluator;
     SegmentedArrayVector<PackedStateBin> state_data_pool;
+    SegmentedVector<size_t> state_hashes;
     std::vector<ap_float> numeric_constants;
     std::vector<int> numeric_indices;
     StateIDSet registered_states;
+    /*
+      If set, this table is used for duplicate detection instead of
+      registered_states (see use_open_addressing).
+    */
+    std::unique_ptr<StateHashTable> open_addressing_states;
+    /*
+      Values of numeric variables with a dictionary encoding (see
+      NumericEncoding), indexed by the code stored in the state buffer.
+    */
+    std::vector<ap_float> numeric_dictionary;
+    std::unordered_map<container_int, container_int> numeric_dictionary_ids;
+    /*
+      Values of the instrumentation variables of all registered states,
+      indexed by StateID. They do not take part in duplicate detection, so
+      they are stored next to the packed state data instead of inside it.
+      The arena is left empty if the task has no instrumentation variables.
+    */
+    const int num_instrumentation_variables;
+    SegmentedArrayVector<ap_float> instrumentation_data;
+    /*
+      Scratch buffers for the generation of successor states. They are reused
+      for all successors, so apart from storing new states, get_successor_state
+      does not allocate memory once they have reached their final size.
+    */
+    std::vector<ap_float> successor_numeric_values;
+    std::vector<ap_float> successor_metric_part;
+    std::vector<ap_float> value_before_change;
+    // Variables changed by the operator (input for the axiom evaluator).
+    std::vector<int> changed_numeric_vars;
+    std::vector<int> changed_logic_vars;
+    // Scratch buffers of register_state.
+    std::vector<PackedStateBin> registered_buffer;
+    std::vector<ap_float> registered_metric_part;
+    size_t num_generated_successors;
+    /*
+      Bins that may differ between a state and its successor besides the
+      bins written by the operator effects, i.e., the bins of derived
+      variables. The other two members are scratch space for collecting the
+      bins that changed.
+    */
+    std::vector<int> derived_bins;
+    std::vector<int> changed_bins;
+    std::vector<bool> bin_is_changed;
+    size_t num_incremental_hashes;
+    /*
+      Scratch buffer for the unpacked values of a state during
+      canonicalization (see get_canonical_successor_state).
+    */
+    std::vector<container_int> canonical_values;
+    /*
+      Direct-mapped cache from successor states before canonicalization to
+      the IDs of their canonical states, so that states in the same orbit
+      that are generated repeatedly are only canonicalized once. Slot i
+      stores the hash value, the state data and the canonical StateID of
+      one state, so collisions are detected. The cache is set up by the
+      first call of get_canonical_successor_state.
+    */
+    std::vector<size_t> canonical_cache_hashes;
+    std::vector<PackedStateBin> canonical_cache_states;
+    std::vector<StateID> canonical_cache_ids;
+    size_t num_canonical_cache_lookups;
+    size_t num_canonical_cache_hits;
     GlobalState *cached_initial_state;
 
     mutable std::set<PerStateInformationBase *> subscribers;
 
-    StateID insert_id_or_pop_state();
+    StateID insert_id_or_pop_state(size_t hash);
+    size_t compute_successor_hash(const GlobalState &predecessor,
+                                  const GlobalOperator &op,
+                                  const PackedStateBin *buffer);
+    container_int get_dictionary_id(ap_float value);
+    void set_instrumentation_values(StateID id, const std::vector<ap_float> &values);
+    void load_successor_buffers(const GlobalState &predecessor);
+    void apply_assign_effects(std::vector<ap_float> &predecessor_vals,
+                              std::vector<ap_float> &metric_part,
+                              const GlobalOperator &op,
+                              PackedStateBin *buffer,
+                              const PackedStateBin *previous_buffer);
+    void canonicalize(std::vector<ap_float> &predecessor_vals, PackedStateBin *buffer);
 
 public:
-    explicit StateRegistry(int number_of_numeric_constants);
+    explicit StateRegistry(int number_of_numeric_constants,
+                           AxiomEvaluator *axiom_evaluator = nullptr);
 
     ~StateRegistry();
 
@@ -170,13 +259,33 @@ public:
 
     GlobalState get_canonical_successor_state(const GlobalState &predecessor, const GlobalOperator &op);
 
+    /*
+      Computes the values of the logic and numeric variables of the state
+      that results from applying op to predecessor without registering it.
+      The values of derived variables are not updated; register_state
+      evaluates the axioms. This is used to send states to other registries.
+    */
+    void get_successor_values(const GlobalState &predecessor, const GlobalOperator &op,
+                              std::vector<container_int> &values,
+                              std::vector<ap_float> &numeric_values);
+
     /*
       Returns the number of states registered so far.
     */
     size_t size() const {
+        if (open_addressing_states)
+            return open_addressing_states->size();
         return registered_states.size();
     }
 
+    /*
+      Switches duplicate detection from std::unordered_set to the
+      open-addressing StateHashTable. States that are already registered
+      are moved to the new table. Registries created while
+      g_use_open_addressing is set use the table from the start.
+    */
+    void use_open_addressing();
+
     /*
       Remembers the given PerStateInformation. If this StateRegistry is
       destroyed, it notifies all subscribed PerStateInformation objects.
@@ -211,6 +320,36 @@ public:
     ap_float evaluate_metric(const std::vector<ap_float> &numeric_state) const;
 
     std::vector<ap_float> get_numeric_vars(const GlobalState &state) const;
+    // Like above, but writes the values into result to avoid an allocation.
+    void get_numeric_vars(const GlobalState &state, std::vector<ap_float> &result) const;
+
+    /*
+      Read and write the value of the regular numeric variable var in a
+      packed state buffer of this registry.
+    */
+    ap_float get_numeric_value(const PackedStateBin *buffer, int var) const;
+    void set_numeric_value(PackedStateBin *buffer, int var, ap_float value);
+
+    /*
+      Access the instrumentation variables of the state with the given ID,
+      indexed like the metric_part of get_numeric_successor. The pointers
+      stay valid as long as the registry exists.
+    */
+    int get_num_instrumentation_variables() const {
+        return num_instrumentation_variables;
+    }
+
+    const ap_float *get_instrumentation_values(StateID id) const {
+        assert(num_instrumentation_variables > 0);
+        return instrumentation_data[id.value];
+    }
+
+    ap_float *get_instrumentation_values(StateID id) {
+        assert(num_instrumentation_variables > 0);
+        return instrumentation_data[id.value];
+    }
+
+    void print_statistics() const;
 
 protected:
     ap_float assign_effect(ap_float aff_value, f_operator fop, ap_float ass_value);
@@ -1,12 +1,16 @@
 #include "successor_generator.h"
 
 #include "global_state.h"
+#include "sampling.h"
 #include "task_tools.h"
 
 #include "utils/collections.h"
+#include "utils/system.h"
+#include "utils/timer.h"
 
 #include <algorithm>
 #include <cassert>
+#include <iostream>
 
 using namespace std;
 
@@ -30,6 +34,50 @@ bool smaller_variable_id(const FactProxy &f1, const FactProxy &f2) {
     return f1.get_variable().get_id() < f2.get_variable().get_id();
 }
 
+/*
+  The decision tree of the successor generator stored in contiguous arrays.
+  Every node refers to a range of operators that are applicable if the node
+  is reached and, for switch nodes, to a range of child indices (one per
+  value of the switch variable) and a default child. Empty subtrees are
+  represented by the index -1 and never visited. Compared to the tree of
+  GeneratorBase objects, this avoids virtual calls, list traversals and
+  most cache misses.
+*/
+class FlatSuccessorGenerator {
+    struct Node {
+        int var; // -1 for leaves
+        int operators_begin;
+        int operators_end;
+        int children_begin;
+        int default_child;
+    };
+
+    TaskProxy task_proxy;
+    std::vector<Node> nodes;
+    std::vector<int> operator_ids;
+    // Parallel to operator_ids.
+    std::vector<const GlobalOperator *> global_operators;
+    std::vector<int> children;
+    int root;
+
+    void generate_applicable_ops(
+        int node_id, const State &state, vector<OperatorProxy> &applicable_ops) const;
+    void generate_applicable_ops(
+        int node_id, const GlobalState &state,
+        vector<const GlobalOperator *> &applicable_ops) const;
+public:
+    FlatSuccessorGenerator(TaskProxy task_proxy, const GeneratorBase &tree_root);
+
+    int add_node(int var, const list<OperatorProxy> &operators);
+    void set_children(int node_id, const vector<int> &children_for_value,
+                      int default_child);
+
+    void generate_applicable_ops(
+        const State &state, vector<OperatorProxy> &applicable_ops) const;
+    void generate_applicable_ops(
+        const GlobalState &state, vector<const GlobalOperator *> &applicable_ops) const;
+};
+
 class GeneratorBase {
 public:
     virtual ~GeneratorBase() = default;
@@ -38,6 +86,8 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, vector<const GlobalOperator *> &applicable_ops) const = 0;
+    // Returns the index of the node in the flat generator (-1 if empty).
+    virtual int add_to(FlatSuccessorGenerator &flat_generator) const = 0;
 };
 
 class GeneratorSwitch : public GeneratorBase {
@@ -56,6 +106,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, vector<const GlobalOperator *> &applicable_ops) const;
+    virtual int add_to(FlatSuccessorGenerator &flat_generator) const;
 };
 
 class GeneratorLeaf : public GeneratorBase {
@@ -67,6 +118,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, vector<const GlobalOperator *> &applicable_ops) const;
+    virtual int add_to(FlatSuccessorGenerator &flat_generator) const;
 };
 
 class GeneratorEmpty : public GeneratorBase {
@@ -76,6 +128,7 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, vector<const GlobalOperator *> &applicable_ops) const;
+    virtual int add_to(FlatSuccessorGenerator &flat_generator) const;
 };
 
 GeneratorSwitch::GeneratorSwitch(
@@ -114,6 +167,17 @@ void GeneratorSwitch::generate_applicable_ops(
     default_generator->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorSwitch::add_to(FlatSuccessorGenerator &flat_generator) const {
+    int node_id = flat_generator.add_node(switch_var.get_id(), immediate_operators);
+    vector<int> children_for_value;
+    children_for_value.reserve(generator_for_value.size());
+    for (GeneratorBase *generator : generator_for_value)
+        children_for_value.push_back(generator->add_to(flat_generator));
+    int default_child = default_generator->add_to(flat_generator);
+    flat_generator.set_children(node_id, children_for_value, default_child);
+    return node_id;
+}
+
 GeneratorLeaf::GeneratorLeaf(list<OperatorProxy> &&applicable_operators)
     : applicable_operators(move(applicable_operators)) {
 }
@@ -132,6 +196,10 @@ void GeneratorLeaf::generate_applicable_ops(
     }
 }
 
+int GeneratorLeaf::add_to(FlatSuccessorGenerator &flat_generator) const {
+    return flat_generator.add_node(-1, applicable_operators);
+}
+
 void GeneratorEmpty::generate_applicable_ops(
     const State &, vector<OperatorProxy> &) const {
 }
@@ -140,6 +208,86 @@ void GeneratorEmpty::generate_applicable_ops(
     const GlobalState &, vector<const GlobalOperator *> &) const {
 }
 
+int GeneratorEmpty::add_to(FlatSuccessorGenerator &) const {
+    return -1;
+}
+
+FlatSuccessorGenerator::FlatSuccessorGenerator(
+    TaskProxy task_proxy, const GeneratorBase &tree_root)
+    : task_proxy(task_proxy) {
+    root = tree_root.add_to(*this);
+    nodes.shrink_to_fit();
+    operator_ids.shrink_to_fit();
+    global_operators.shrink_to_fit();
+    children.shrink_to_fit();
+}
+
+int FlatSuccessorGenerator::add_node(int var, const list<OperatorProxy> &operators) {
+    Node node;
+    node.var = var;
+    node.operators_begin = operator_ids.size();
+    for (OperatorProxy op : operators) {
+        operator_ids.push_back(op.get_id());
+        global_operators.push_back(op.get_global_operator());
+    }
+    node.operators_end = operator_ids.size();
+    node.children_begin = -1;
+    node.default_child = -1;
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+void FlatSuccessorGenerator::set_children(
+    int node_id, const vector<int> &children_for_value, int default_child) {
+    nodes[node_id].children_begin = children.size();
+    nodes[node_id].default_child = default_child;
+    children.insert(children.end(), children_for_value.begin(), children_for_value.end());
+}
+
+void FlatSuccessorGenerator::generate_applicable_ops(
+    int node_id, const State &state, vector<OperatorProxy> &applicable_ops) const {
+    OperatorsProxy operators = task_proxy.get_operators();
+    // Follow the default children iteratively and the value children recursively.
+    while (node_id != -1) {
+        const Node &node = nodes[node_id];
+        for (int i = node.operators_begin; i < node.operators_end; ++i)
+            applicable_ops.push_back(operators[operator_ids[i]]);
+        if (node.var == -1)
+            return;
+        int child = children[node.children_begin + state[node.var].get_value()];
+        if (child != -1)
+            generate_applicable_ops(child, state, applicable_ops);
+        node_id = node.default_child;
+    }
+}
+
+void FlatSuccessorGenerator::generate_applicable_ops(
+    int node_id, const GlobalState &state,
+    vector<const GlobalOperator *> &applicable_ops) const {
+    while (node_id != -1) {
+        const Node &node = nodes[node_id];
+        applicable_ops.insert(applicable_ops.end(),
+                              global_operators.begin() + node.operators_begin,
+                              global_operators.begin() + node.operators_end);
+        if (node.var == -1)
+            return;
+        int child = children[node.children_begin + state[node.var]];
+        if (child != -1)
+            generate_applicable_ops(child, state, applicable_ops);
+        node_id = node.default_child;
+    }
+}
+
+void FlatSuccessorGenerator::generate_applicable_ops(
+    const State &state, vector<OperatorProxy> &applicable_ops) const {
+    generate_applicable_ops(root, state, applicable_ops);
+}
+
+void FlatSuccessorGenerator::generate_applicable_ops(
+    const GlobalState &state, vector<const GlobalOperator *> &applicable_ops) const {
+    generate_applicable_ops(root, state, applicable_ops);
+}
+
 SuccessorGenerator::SuccessorGenerator(const shared_ptr<AbstractTask> task)
     : task(task),
       task_proxy(*task) {
@@ -241,13 +389,83 @@ GeneratorBase *SuccessorGenerator::construct_recursive(
     }
 }
 
+void SuccessorGenerator::use_flat_representation() {
+    if (flat_generator)
+        return;
+    flat_generator = unique_ptr<FlatSuccessorGenerator>(
+        new FlatSuccessorGenerator(task_proxy, *root));
+    root = nullptr;
+}
+
 void SuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorProxy> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+    if (flat_generator)
+        flat_generator->generate_applicable_ops(state, applicable_ops);
+    else
+        root->generate_applicable_ops(state, applicable_ops);
 }
 
 
 void SuccessorGenerator::generate_applicable_ops(
     const GlobalState &state, std::vector<const GlobalOperator *> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+    if (flat_generator)
+        flat_generator->generate_applicable_ops(state, applicable_ops);
+    else
+        root->generate_applicable_ops(state, applicable_ops);
+}
+
+static double time_successor_generator(
+    const SuccessorGenerator &successor_generator, const vector<State> &states,
+    int num_rounds, long long &num_applicable_ops) {
+    vector<OperatorProxy> applicable_ops;
+    num_applicable_ops = 0;
+    utils::Timer timer;
+    for (int round = 0; round < num_rounds; ++round) {
+        for (const State &state : states) {
+            applicable_ops.clear();
+            successor_generator.generate_applicable_ops(state, applicable_ops);
+            num_applicable_ops += applicable_ops.size();
+        }
+    }
+    return timer.stop();
+}
+
+void benchmark_successor_generators(
+    const shared_ptr<AbstractTask> task, int num_samples) {
+    TaskProxy task_proxy(*task);
+    SuccessorGenerator tree_generator(task);
+    SuccessorGenerator flat_generator(task);
+    flat_generator.use_flat_representation();
+
+    vector<State> states = sample_states_with_random_walks(
+        task_proxy, tree_generator, num_samples, 0,
+        get_average_operator_cost(task_proxy));
+
+    // Both generators must produce the same operators in the same order.
+    vector<OperatorProxy> tree_ops;
+    vector<OperatorProxy> flat_ops;
+    for (const State &state : states) {
+        tree_ops.clear();
+        flat_ops.clear();
+        tree_generator.generate_applicable_ops(state, tree_ops);
+        flat_generator.generate_applicable_ops(state, flat_ops);
+        if (tree_ops != flat_ops) {
+            cerr << "Successor generators disagree on a sampled state" << endl;
+            utils::exit_with(utils::ExitCode::CRITICAL_ERROR);
+        }
+    }
+
+    const int num_rounds = 10;
+    long long num_tree_ops;
+    long long num_flat_ops;
+    double tree_time = time_successor_generator(
+        tree_generator, states, num_rounds, num_tree_ops);
+    double flat_time = time_successor_generator(
+        flat_generator, states, num_rounds, num_flat_ops);
+    assert(num_tree_ops == num_flat_ops);
+    cout << "Successor generator benchmark: " << states.size()
+         << " sampled states, " << num_rounds << " rounds, "
+         << num_tree_ops << " applicable operators" << endl;
+    cout << "Tree successor generator time: " << tree_time << "s" << endl;
+    cout << "Flat successor generator time: " << flat_time << "s" << endl;
 }
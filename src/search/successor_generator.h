@@ -8,6 +8,7 @@
 #include <vector>
 
 class AbstractTask;
+class FlatSuccessorGenerator;
 class GeneratorBase;
 class GlobalOperator;
 class GlobalState;
@@ -19,6 +20,7 @@ class SuccessorGenerator {
     TaskProxy task_proxy;
 
     std::unique_ptr<GeneratorBase> root;
+    std::unique_ptr<FlatSuccessorGenerator> flat_generator;
 
     typedef std::vector<FactProxy> Condition;
     GeneratorBase *construct_recursive(
@@ -32,6 +34,14 @@ public:
     SuccessorGenerator(const std::shared_ptr<AbstractTask> task);
     ~SuccessorGenerator();
 
+    /*
+      Replace the tree of generator nodes by a representation that stores
+      the decision tree in a few contiguous arrays (see
+      FlatSuccessorGenerator). Both representations generate the same
+      operators in the same order.
+    */
+    void use_flat_representation();
+
     void generate_applicable_ops(
         const State &state, std::vector<OperatorProxy> &applicable_ops) const;
     // Transitional method, used until the search is switched to the new task interface.
@@ -39,4 +49,11 @@ public:
         const GlobalState &state, std::vector<const GlobalOperator *> &applicable_ops) const;
 };
 
+/*
+  Compare the speed of the tree and the flat representation of the
+  successor generator on states sampled with random walks.
+*/
+extern void benchmark_successor_generators(
+    const std::shared_ptr<AbstractTask> task, int num_samples);
+
 #endif
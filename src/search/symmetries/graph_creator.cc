@@ -15,7 +15,8 @@ GraphCreator::GraphCreator(const Options &opts)
       no_search(opts.get<bool>("no_search")),
       initialized(false),
       ignore_numeric(opts.get<bool>("ignore_numeric")),
-      precision(opts.get<ap_float>("precision")) {
+      precision(opts.get<ap_float>("precision")),
+      canonical_cache_size(opts.get<int>("canonical_cache_size")) {
 }
 
 
@@ -572,6 +573,11 @@ void GraphCreator::add_options_to_parser(OptionParser &parser) {
 
 
     parser.add_option<ap_float>("precision", "Threshold below which is considered as zero", "0.00001");
+    parser.add_option<int>("canonical_cache_size",
+                           "Number of entries of the cache that maps successor states to their "
+                           "canonical states (0 disables the cache)",
+                           "65536",
+                           Bounds("0", "infinity"));
 }
 
 
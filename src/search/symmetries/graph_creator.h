@@ -25,6 +25,7 @@ class GraphCreator  {
     bool initialized;
     bool ignore_numeric;
     ap_float precision;
+    int canonical_cache_size;
 
 public:
 
@@ -37,10 +38,13 @@ public:
         group.get_canonical_state(values, num_values);
     }
 
-    bool to_canonical_state(PackedStateBin* buffer, std::vector<ap_float> &num_values) const {
-        return group.to_canonical_state(buffer, num_values);
+    bool to_canonical_state(PackedStateBin* buffer, std::vector<container_int> &values,
+                            std::vector<ap_float> &num_values) const {
+        return group.to_canonical_state(buffer, values, num_values);
     }
 
+    int get_canonical_cache_size() const { return canonical_cache_size; }
+
     Permutation create_permutation_from_state_to_state(const GlobalState &from_state, const GlobalState &to_state) const;
 
     static void add_options_to_parser(OptionParser &parser);
@@ -165,64 +165,52 @@ void Group::get_canonical_state(std::vector<container_int> &values, std::vector<
       calculate_canonical_state_subgroup(i, values, num_values);
 }
 
-void Group::calculate_canonical_state_subgroup(int ind, std::vector<container_int> &values, std::vector<ap_float> &num_values) const {
+bool Group::calculate_canonical_state_subgroup(int ind, std::vector<container_int> &values, std::vector<ap_float> &num_values) const {
     // Going to the best successor, continue until local minima is reached
     // Warning: before running the method, the state is copied into the original_state.
     //          after finishing the run, the minimal state is in original_state
     int size = sub_groups[ind].size();
     if (size == 0)
-        return;
+        return false;
 
 //	cout << "Starting canonical state calculation:" << endl;
 //	cout << "---------------------------------------------------------------------------------" << endl;
 //	State(original_state).dump();
+    bool changed_at_least_once = false;
     bool changed = true;
     while (changed) {
         changed = false;
         for (int i=0; i < size; i++) {
             if (generators[sub_groups[ind][i]].replace_if_less(values, num_values)) {
                 changed =  true;
+                changed_at_least_once = true;
 //				cout << "---------------------------------------------------------------------------------" << endl;
 //				State(original_state).dump();
             }
         }
     }
 //	cout << "==================================================================================" << endl;
-
+    return changed_at_least_once;
 }
 
-bool Group::to_canonical_state(PackedStateBin *buffer, std::vector<ap_float> &num_values) const {
-    bool changed = false;
+bool Group::to_canonical_state(PackedStateBin *buffer, std::vector<container_int> &values,
+                               std::vector<ap_float> &num_values) const {
+    int num_variables = g_variable_domain.size();
+    values.resize(num_variables);
+    for (int var = 0; var < num_variables; ++var)
+        values[var] = g_state_packer->get(buffer, var);
 
+    bool changed = false;
     for (size_t i = 0; i < sub_groups.size(); i++) {
-      if (to_canonical_state_subgroup(i, buffer, num_values) && !changed) 
+      if (calculate_canonical_state_subgroup(i, values, num_values))
         changed = true;
     }
 
-    return changed;
-}
-
-bool Group::to_canonical_state_subgroup(int ind, PackedStateBin *buffer, std::vector<ap_float> &num_values) const {
-    // Going to the best successor, continue until local minima is reached
-    // Warning: before running the method, the state is copied into the original_state.
-    //          after finishing the run, the minimal state is in original_state
-    int size = sub_groups[ind].size();
-    if (size == 0)
-        return false;
-
-    bool changed_at_least_once = false;
-    bool changed = true;
-    while (changed) {
-        changed = false;
-        for (int i=0; i < size; i++) {
-            if (generators[sub_groups[ind][i]].replace_if_less(buffer, num_values)) {
-                changed = true;
-                if (!changed_at_least_once) changed_at_least_once = true;
-            }
-        }
+    if (changed) {
+        for (int var = 0; var < num_variables; ++var)
+            g_state_packer->set(buffer, var, values[var]);
     }
-
-    return changed_at_least_once;
+    return changed;
 }
 
 std::vector<int> Group::get_trace(std::vector<container_int> &values, std::vector<ap_float> &num_values) const {
@@ -26,7 +26,13 @@ public:
     int get_num_generators() const;
     void dump_generators() const;
     void get_canonical_state(std::vector<container_int> &values, std::vector<ap_float> &num_values) const;
-    bool to_canonical_state(PackedStateBin* buffer, std::vector<ap_float> &num_values) const;
+    /*
+      Replaces the packed state by its canonical state. The state is unpacked
+      into values once, so the generators work on plain arrays. Returns true
+      if the state changed.
+    */
+    bool to_canonical_state(PackedStateBin* buffer, std::vector<container_int> &values,
+                            std::vector<ap_float> &num_values) const;
     std::vector<int> get_trace(std::vector<container_int> &values, std::vector<ap_float> &num_values) const;
     Permutation compose_permutation(const std::vector<int> &trace) const;
 
@@ -46,8 +52,7 @@ private:
     // Methods for finding a canonical state for each state.
     const Permutation& get_permutation(int) const;
 
-    void calculate_canonical_state_subgroup(int ind, std::vector<container_int> &values, std::vector<ap_float> &num_values) const;
-    bool to_canonical_state_subgroup(int ind, PackedStateBin* buffer, std::vector<ap_float> &num_values) const;
+    bool calculate_canonical_state_subgroup(int ind, std::vector<container_int> &values, std::vector<ap_float> &num_values) const;
     void get_trace_subgroup(int ind, std::vector<container_int> &values, std::vector<ap_float> &num_values, std::vector<int> &trace) const;
 
     void dump_subgroups() const;
@@ -159,6 +159,18 @@ void Permutation::finalize(){
         }
         affected_num_vars_cycles.push_back(cycle);
     }
+
+    /*
+      Precompute the new values of the affected variables, so that
+      replace_if_less only needs one lookup per variable.
+    */
+    to_value_offsets.assign(var_to_regular_id.size(), -1);
+    to_values.clear();
+    for (int var : vars_affected) {
+        to_value_offsets[var] = to_values.size();
+        for (int value = 0; value < static_cast<int>(g_variable_domain[var]); ++value)
+            to_values.push_back(get_new_var_val_by_old_var_val(var, value).second);
+    }
 }
 
 bool Permutation::identity() const{
@@ -325,9 +337,8 @@ bool Permutation::replace_if_less(std::vector<container_int> &values, std::vecto
         int to_var = vars_affected[i];
         int from_var = from_vars[to_var];
         int from_val = values[from_var];
-        pair<int, int> to_var_val = get_new_var_val_by_old_var_val(from_var, from_val);
-        assert(to_var == to_var_val.first);
-        int to_val = to_var_val.second;
+        assert(to_var == get_new_var_val_by_old_var_val(from_var, from_val).first);
+        int to_val = get_new_value(from_var, from_val);
 
         // Check if the values are the same, then continue to the next aff. var.
         if (to_val < static_cast<int>(values[to_var])) {
@@ -341,10 +352,7 @@ bool Permutation::replace_if_less(std::vector<container_int> &values, std::vecto
         for (int i = 0, n = affected_vars_cycles.size(); i < n; i++) {
             if (affected_vars_cycles[i].size() == 1) {
                 int var = affected_vars_cycles[i][0];
-                int from_val = values[var];
-                pair<int, int> to_var_val = get_new_var_val_by_old_var_val(var, from_val);
-                assert(var == to_var_val.first);
-                values[var] = to_var_val.second;
+                values[var] = get_new_value(var, values[var]);
                 continue;
             }
             // Remembering one value to be rewritten last
@@ -355,14 +363,11 @@ bool Permutation::replace_if_less(std::vector<container_int> &values, std::vecto
                 // writing into variable affected_vars_cycles[i][j]
                 int to_var = affected_vars_cycles[i][j];
                 int from_var = affected_vars_cycles[i][j - 1];
-                int from_val = values[from_var];
-                pair<int, int> to_var_val = get_new_var_val_by_old_var_val(from_var, from_val);
-                assert(to_var == to_var_val.first);
-                values[to_var] = to_var_val.second;
+                assert(to_var == get_new_var_val_by_old_var_val(from_var, values[from_var]).first);
+                values[to_var] = get_new_value(from_var, values[from_var]);
             }
             // writing the last one
-            pair<int, int> to_var_val = get_new_var_val_by_old_var_val(last_var, last_val);
-            values[affected_vars_cycles[i][0]] = to_var_val.second;
+            values[affected_vars_cycles[i][0]] = get_new_value(last_var, last_val);
         }
     } 
 
@@ -397,89 +402,6 @@ bool Permutation::replace_if_less(std::vector<container_int> &values, std::vecto
     return !values_same || !num_values_same;
 }
 
-bool Permutation::replace_if_less(PackedStateBin *buffer, std::vector<ap_float> &num_values) const {
-    if (identity())
-        return false;
-
-    bool values_same = true;
-    // Going over the affected variables, comparing the resulted values with the state values.
-    for (int i = vars_affected.size() - 1; i >= 0; i--) {
-        int to_var = vars_affected[i];
-        int from_var = from_vars[to_var];
-        int from_val = g_state_packer->get(buffer, from_var);
-        pair<int, int> to_var_val = get_new_var_val_by_old_var_val(from_var, from_val);
-        assert(to_var == to_var_val.first);
-        int to_val = to_var_val.second;
-        int current_to_val = g_state_packer->get(buffer, to_var);
-
-        // Check if the values are the same, then continue to the next aff. var.
-        if (to_val < current_to_val) {
-            values_same = false;
-            break;
-        } else if (to_val > current_to_val) {
-            return false;
-        }
-    }
-    if (!values_same) {
-        for (int i = 0, n = affected_vars_cycles.size(); i < n; i++) {
-            if (affected_vars_cycles[i].size() == 1) {
-                int var = affected_vars_cycles[i][0];
-                int from_val = g_state_packer->get(buffer, var);
-                pair<int, int> to_var_val = get_new_var_val_by_old_var_val(var, from_val);
-                assert(var == to_var_val.first);
-                g_state_packer->set(buffer, var, to_var_val.second);
-                continue;
-            }
-            // Remembering one value to be rewritten last
-            int last_var = affected_vars_cycles[i][affected_vars_cycles[i].size() - 1];
-            int last_val = g_state_packer->get(buffer, last_var);
-
-            for (int j = affected_vars_cycles[i].size() - 1; j > 0; j--) {
-                // writing into variable affected_vars_cycles[i][j]
-                int to_var = affected_vars_cycles[i][j];
-                int from_var = affected_vars_cycles[i][j - 1];
-                int from_val = g_state_packer->get(buffer, from_var);
-                pair<int, int> to_var_val = get_new_var_val_by_old_var_val(from_var, from_val);
-                assert(to_var == to_var_val.first);
-                g_state_packer->set(buffer, to_var, to_var_val.second);
-            }
-            // writing the last one
-            pair<int, int> to_var_val = get_new_var_val_by_old_var_val(last_var, last_val);
-            g_state_packer->set(buffer, affected_vars_cycles[i][0], to_var_val.second);
-        }
-    }
-
-    bool num_values_same = true;
-    for (int i = num_vars_affected.size() - 1; i >= 0; i--) {
-        int to_var = num_vars_affected[i];
-        int from_var = from_num_vars[to_var];
-
-        // Check if the values are the same, then continue to the next aff. var.
-        if (values_same && num_values[from_var] > num_values[to_var]) {
-            return false;
-        } else if (num_values[from_var] != num_values[to_var]) {
-            num_values_same = false;
-            break;
-        }
-    }
-    if (!num_values_same) {
-        for (int i = 0, n = affected_num_vars_cycles.size(); i < n; i++) {
-            int last_var = affected_num_vars_cycles[i][affected_num_vars_cycles[i].size() - 1];
-            ap_float last_val = num_values[last_var];
-
-            for (int j = affected_num_vars_cycles[i].size() - 1; j > 0; j--) {
-                int to_num_var = affected_num_vars_cycles[i][j];
-                int from_num_var = affected_num_vars_cycles[i][j - 1];
-                num_values[to_num_var] = num_values[from_num_var];
-            }
-
-            num_values[affected_num_vars_cycles[i][0]] = last_val;
-        }
-    }
-
-    return !values_same || !num_values_same;
-}
-
 void Permutation::print_cycle_notation() const {
     vector<int> done;
     int id_min = static_cast<int>(regular_id_to_var.size());
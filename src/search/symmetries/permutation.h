@@ -46,7 +46,6 @@ public:
     static std::vector<int> regular_id_to_num_var;
 
     bool replace_if_less(std::vector<container_int> &values, std::vector<ap_float> &num_values) const;
-    bool replace_if_less(PackedStateBin *buffer, std::vector<ap_float> &num_values) const;
 
 private:
     int* value;
@@ -61,11 +60,18 @@ private:
     // Affected vars by cycles
     std::vector<std::vector<int> > affected_vars_cycles;
     std::vector<std::vector<int> > affected_num_vars_cycles;
+    // The new value of each value of an affected variable, indexed by
+    // to_value_offsets[var] + value (-1 for unaffected variables).
+    std::vector<int> to_value_offsets;
+    std::vector<int> to_values;
 
     void set_affected(int ind, int val);
     bool is_numeric(int ind) const { return ind >= dom_sum_num_var; }
     std::pair<int, int> get_new_var_val_by_old_var_val(int var, int value) const;
     int get_new_num_var_by_old_num_var(int var) const;
+    int get_new_value(int var, int value) const {
+        return to_values[to_value_offsets[var] + value];
+    }
 
     void finalize();
     void _allocate();
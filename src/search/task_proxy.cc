@@ -56,8 +56,9 @@ void State::get_numeric_successor(
         }
     }
 
-    g_axiom_evaluator->evaluate_arithmetic_axioms(new_num_state);
-    g_axiom_evaluator->evaluate(new_state, new_num_state); // evaluate logic + comparison axioms (we need this for the goal axiom)
+    AxiomEvaluator &axiom_evaluator = get_thread_axiom_evaluator();
+    axiom_evaluator.evaluate_arithmetic_axioms(new_num_state);
+    axiom_evaluator.evaluate(new_state, new_num_state); // evaluate logic + comparison axioms (we need this for the goal axiom)
 }
 
 State State::get_successor(OperatorProxy op) const {
@@ -75,7 +76,7 @@ State State::get_successor(OperatorProxy op) const {
 
     if(has_numeric_axioms()) {
         // TODO not sure if this is really needed here
-        g_axiom_evaluator->evaluate_arithmetic_axioms(new_num_values);
+        get_thread_axiom_evaluator().evaluate_arithmetic_axioms(new_num_values);
     }
 
     get_numeric_successor(new_num_values,
@@ -0,0 +1,131 @@
+#include "task_reader.h"
+
+#include "utils/mapped_file.h"
+#include "utils/memory.h"
+#include "utils/system.h"
+
+#include <binary_task_format.h>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+using namespace std;
+using utils::ExitCode;
+
+TaskReader::TaskReader(istream &in)
+    : in(in),
+      binary(in.peek() == BINARY_TASK_MAGIC[0]),
+      data(nullptr),
+      size(0),
+      pos(0) {
+    if (binary) {
+        read_binary_input();
+        check_header();
+    }
+}
+
+TaskReader::~TaskReader() {
+}
+
+void TaskReader::read_binary_input() {
+    if (&in == &cin) {
+        file = utils::make_unique_ptr<utils::MappedFile>("/dev/stdin");
+        if (file->is_open()) {
+            data = file->get_data();
+            size = file->get_size();
+            cout << "mapped binary task file into memory" << endl;
+            return;
+        }
+    }
+    // Standard input is a pipe or the task is read from another stream.
+    buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+}
+
+void TaskReader::check_header() {
+    if (size < BINARY_TASK_HEADER_SIZE ||
+        memcmp(data, BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC)) != 0) {
+        fail("missing header");
+    }
+    uint32_t version;
+    memcpy(&version, data + sizeof(BINARY_TASK_MAGIC), sizeof(version));
+    if (version != BINARY_TASK_VERSION) {
+        fail("expected version " + to_string(BINARY_TASK_VERSION) +
+             ", got " + to_string(version));
+    }
+    pos = BINARY_TASK_HEADER_SIZE;
+}
+
+void TaskReader::fail(const string &message) const {
+    cerr << "Invalid binary task file: " << message << endl;
+    utils::exit_with(ExitCode::INPUT_ERROR);
+}
+
+void TaskReader::read_bytes(void *dest, size_t num_bytes) {
+    if (num_bytes > size - pos)
+        fail("unexpected end of file");
+    memcpy(dest, data + pos, num_bytes);
+    pos += num_bytes;
+}
+
+uint8_t TaskReader::read_tag() {
+    uint8_t tag;
+    read_bytes(&tag, sizeof(tag));
+    return tag;
+}
+
+long long TaskReader::read_int() {
+    uint8_t tag = read_tag();
+    if (tag == TOKEN_INT) {
+        int64_t value;
+        read_bytes(&value, sizeof(value));
+        return value;
+    } else if (tag == TOKEN_FLOAT) {
+        double value;
+        read_bytes(&value, sizeof(value));
+        if (value == static_cast<long long>(value))
+            return value;
+    }
+    fail("expected an integer at position " + to_string(pos - 1));
+}
+
+double TaskReader::read_float() {
+    uint8_t tag = read_tag();
+    if (tag == TOKEN_FLOAT) {
+        double value;
+        read_bytes(&value, sizeof(value));
+        return value;
+    } else if (tag == TOKEN_INT) {
+        int64_t value;
+        read_bytes(&value, sizeof(value));
+        return value;
+    }
+    fail("expected a number at position " + to_string(pos - 1));
+}
+
+string TaskReader::read_string() {
+    uint8_t tag = read_tag();
+    if (tag == TOKEN_INT) {
+        int64_t value;
+        read_bytes(&value, sizeof(value));
+        return to_string(value);
+    } else if (tag != TOKEN_STRING) {
+        fail("expected a string at position " + to_string(pos - 1));
+    }
+    uint32_t length;
+    read_bytes(&length, sizeof(length));
+    if (length > size - pos)
+        fail("unexpected end of file");
+    string result(data + pos, length);
+    pos += length;
+    return result;
+}
+
+TaskReader &getline(TaskReader &reader, string &line) {
+    if (reader.binary)
+        line = reader.read_string();
+    else
+        getline(reader.in, line);
+    return reader;
+}
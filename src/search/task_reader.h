@@ -0,0 +1,94 @@
+#ifndef TASK_READER_H
+#define TASK_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+class MappedFile;
+}
+
+/*
+  Reads the output of the preprocessor, which is either in text format or
+  in the binary format written by "preprocess --binary-output" (see
+  src/preprocess/task_writer.h). The binary format is detected by its
+  magic number at the start of the input. It contains the same values as
+  the text format, but every value is stored as a token with a type tag,
+  so reading it needs no parsing.
+
+  TaskReader is used like an istream. In text mode, everything is
+  forwarded to the stream. In binary mode, "in >> value" reads the next
+  token and getline(in, line) reads a string token, since strings with
+  spaces are stored as one token. Enum values are stored as strings in
+  their text representation and converted with their operator>>.
+
+  If the binary task is read from standard input that is redirected from a
+  file, the file is mapped into memory. Otherwise, the input is read into
+  a buffer.
+*/
+class TaskReader {
+    std::istream &in;
+    bool binary;
+
+    std::unique_ptr<utils::MappedFile> file;
+    std::vector<char> buffer;
+    const char *data;
+    std::size_t size;
+    std::size_t pos;
+
+    void read_binary_input();
+    void check_header();
+    void read_bytes(void *dest, std::size_t num_bytes);
+    std::uint8_t read_tag();
+    [[noreturn]] void fail(const std::string &message) const;
+
+    long long read_int();
+    double read_float();
+    std::string read_string();
+public:
+    explicit TaskReader(std::istream &in);
+    ~TaskReader();
+
+    bool is_binary() const {
+        return binary;
+    }
+
+    template<typename T>
+    TaskReader &operator>>(T &value) {
+        if (!binary) {
+            in >> value;
+        } else if constexpr (std::is_same<T, char>::value) {
+            std::string text = read_string();
+            value = text.empty() ? '\0' : text[0];
+        } else if constexpr (std::is_integral<T>::value) {
+            value = static_cast<T>(read_int());
+        } else if constexpr (std::is_floating_point<T>::value) {
+            value = static_cast<T>(read_float());
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            value = read_string();
+        } else {
+            std::istringstream text(read_string());
+            text >> value;
+        }
+        return *this;
+    }
+
+    // Manipulators (e.g., std::ws) are ignored in binary mode.
+    TaskReader &operator>>(std::istream &(*manipulator)(std::istream &)) {
+        if (!binary)
+            in >> manipulator;
+        return *this;
+    }
+
+    friend TaskReader &getline(TaskReader &reader, std::string &line);
+};
+
+extern TaskReader &getline(TaskReader &reader, std::string &line);
+
+#endif
@@ -81,3 +81,88 @@ ap_float get_average_operator_cost(TaskProxy task_proxy) {
     average_operator_cost /= task_proxy.get_operators().size();
     return average_operator_cost;
 }
+
+static bool mark_relevant(vector<bool> &relevant, int var) {
+    if (relevant[var])
+        return false;
+    relevant[var] = true;
+    return true;
+}
+
+/*
+  Marks the condition variables of op and the numeric variables assigned to
+  relevant numeric variables if op affects a relevant variable. Returns
+  true if a new variable became relevant.
+*/
+static bool mark_relevant_conditions(
+    OperatorProxy op, vector<bool> &relevant, vector<bool> &numeric_relevant) {
+    bool affects_relevant = false;
+    for (EffectProxy effect : op.get_effects()) {
+        if (relevant[effect.get_fact().get_variable().get_id()])
+            affects_relevant = true;
+    }
+    for (AssEffectProxy effect : op.get_ass_effects()) {
+        if (numeric_relevant[effect.get_assignment().get_affected_variable().get_id()])
+            affects_relevant = true;
+    }
+    if (!affects_relevant)
+        return false;
+
+    bool changed = false;
+    for (FactProxy precondition : op.get_preconditions())
+        changed |= mark_relevant(relevant, precondition.get_variable().get_id());
+    for (EffectProxy effect : op.get_effects()) {
+        for (FactProxy condition : effect.get_conditions())
+            changed |= mark_relevant(relevant, condition.get_variable().get_id());
+    }
+    for (AssEffectProxy effect : op.get_ass_effects()) {
+        NumAssProxy assignment = effect.get_assignment();
+        if (!numeric_relevant[assignment.get_affected_variable().get_id()])
+            continue;
+        changed |= mark_relevant(numeric_relevant, assignment.get_assigned_variable().get_id());
+        for (FactProxy condition : effect.get_conditions())
+            changed |= mark_relevant(relevant, condition.get_variable().get_id());
+    }
+    return changed;
+}
+
+void compute_goal_relevant_variables(
+    TaskProxy task, vector<int> &variables, vector<int> &numeric_variables) {
+    vector<bool> relevant(task.get_variables().size(), false);
+    vector<bool> numeric_relevant(task.get_numeric_variables().size(), false);
+    for (FactProxy goal : task.get_goals())
+        relevant[goal.get_variable().get_id()] = true;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (OperatorProxy op : task.get_operators())
+            changed |= mark_relevant_conditions(op, relevant, numeric_relevant);
+        for (OperatorProxy axiom : task.get_axioms())
+            changed |= mark_relevant_conditions(axiom, relevant, numeric_relevant);
+        for (ComparisonAxiomProxy axiom : task.get_comparison_axioms()) {
+            if (relevant[axiom.get_true_fact().get_variable().get_id()] ||
+                relevant[axiom.get_false_fact().get_variable().get_id()]) {
+                changed |= mark_relevant(numeric_relevant, axiom.get_left_variable().get_id());
+                changed |= mark_relevant(numeric_relevant, axiom.get_right_variable().get_id());
+            }
+        }
+        for (AssignmentAxiomProxy axiom : task.get_assignment_axioms()) {
+            if (numeric_relevant[axiom.get_assignment_variable().get_id()]) {
+                changed |= mark_relevant(numeric_relevant, axiom.get_left_variable().get_id());
+                changed |= mark_relevant(numeric_relevant, axiom.get_right_variable().get_id());
+            }
+        }
+    }
+
+    variables.clear();
+    for (size_t var = 0; var < relevant.size(); ++var) {
+        if (relevant[var])
+            variables.push_back(var);
+    }
+    numeric_variables.clear();
+    for (size_t var = 0; var < numeric_relevant.size(); ++var) {
+        if (numeric_relevant[var])
+            numeric_variables.push_back(var);
+    }
+}
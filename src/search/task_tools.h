@@ -50,4 +50,20 @@ void verify_no_conditional_effects(TaskProxy task);
 
 ap_float get_average_operator_cost(TaskProxy task_proxy);
 
+/*
+  Compute the (regular and numeric) variables that can influence whether
+  and how the goal is reached: the goal variables and, transitively, the
+  variables in the conditions of operators and axioms that affect a
+  relevant variable as well as the numeric variables that are assigned to
+  or compared with relevant variables. The heuristic value of a relaxation
+  of the task only depends on the values of these variables. The result is
+  sorted.
+
+  Runtime: O(kn), where n is the size of the task and k is the number of
+  relevant variables.
+*/
+void compute_goal_relevant_variables(
+    TaskProxy task, std::vector<int> &variables,
+    std::vector<int> &numeric_variables);
+
 #endif
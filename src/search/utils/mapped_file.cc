@@ -0,0 +1,64 @@
+#include "mapped_file.h"
+
+#include "system.h"
+
+#include <fstream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+MappedFile::MappedFile(const string &filename)
+    : data(nullptr),
+      size(0),
+      mapped(false) {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        void *address = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            data = static_cast<const char *>(address);
+            size = file_stat.st_size;
+            mapped = true;
+        }
+    }
+    close(fd);
+    if (mapped)
+        return;
+#endif
+    ifstream file(filename, ios::binary);
+    if (!file)
+        return;
+    file.seekg(0, ios::end);
+    streamoff file_size = file.tellg();
+    if (file_size <= 0)
+        return;
+    file.seekg(0, ios::beg);
+    // Leave room to align the start of the data.
+    buffer.resize(file_size + sizeof(double));
+    char *start = buffer.data();
+    size_t misalignment = reinterpret_cast<size_t>(start) % sizeof(double);
+    if (misalignment != 0)
+        start += sizeof(double) - misalignment;
+    if (file.read(start, file_size)) {
+        data = start;
+        size = file_size;
+    }
+}
+
+MappedFile::~MappedFile() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    if (mapped)
+        munmap(const_cast<char *>(data), size);
+#endif
+}
+}
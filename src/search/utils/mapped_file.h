@@ -0,0 +1,45 @@
+#ifndef UTILS_MAPPED_FILE_H
+#define UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  Read-only view of the contents of a file. On Unix systems, the file is
+  mapped into memory with mmap, so only the pages that are accessed are
+  read from disk and they can be shared between processes. On other
+  systems, the file is read into a buffer.
+
+  The data is aligned to at least 8 bytes. If the file cannot be opened,
+  is_open() returns false and the view is empty.
+*/
+class MappedFile {
+    const char *data;
+    std::size_t size;
+    bool mapped;
+    std::vector<char> buffer;
+
+public:
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool is_open() const {
+        return data != nullptr;
+    }
+
+    const char *get_data() const {
+        return data;
+    }
+
+    std::size_t get_size() const {
+        return size;
+    }
+};
+}
+
+#endif
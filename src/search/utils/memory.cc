@@ -1,7 +1,9 @@
 #include "memory.h"
 
 #include <cassert>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 
 using namespace std;
 